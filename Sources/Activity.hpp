@@ -0,0 +1,779 @@
+/*
+// Copyright (c) 2012-2015 Pierre Guillot, Eliott Paris & Thomas Le Meur CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef DEF_HOA_ACTIVITY_LIGHT
+#define DEF_HOA_ACTIVITY_LIGHT
+
+#include "Scope.hpp"
+
+namespace hoa
+{
+    //! The activity class localizes the sources of the sound field.
+    /** The activity accumulates the covariance of the harmonics over a window of samples and evaluates the steered response power of the sound field on the points of a scope, then it retrieves the directions of the strongest peaks of the power map. The work is split in two parts: the processBlock method only accumulates the covariance and should be called by the digital signal processing, the analyze method evaluates the power map and the peaks and should be called at the rate of the analysis by a worker thread or by a graphical interface. With C++11, the covariance is passed from one method to the other through a snapshot, so none of them lock or wait.
+     */
+    template <Dimension D, typename T> class Activity : public Processor<D, T>::Harmonics
+    {
+    public:
+
+        //! The activity constructor.
+        /**	The activity constructor allocates and initialize the member values to localize the sources depending on a order of decomposition, a number of points and a number of peaks. The order must be at least 1.
+         @param     order            The order.
+         @param     numberOfPoints   The number of points.
+         @param     numberOfPeaks    The maximum number of peaks.
+         */
+        Activity(size_t order, size_t numberOfPoints, size_t numberOfPeaks);
+
+        //! The activity destructor.
+        /**	The activity destructor free the memory.
+         */
+        virtual ~Activity() hoa_noexcept = 0;
+
+        //! Set the size of the window of the analysis.
+        /** Set the number of samples over which the covariance is accumulated, that defines the rate of the analysis, for example 4096 samples at 44.1 kHz for about 11 analysis per second. The current window is restarted.
+         @param     size   The number of samples of the window.
+         */
+        virtual void setWindowSize(const size_t size) hoa_noexcept = 0;
+
+        //! This method accumulates the covariance of a block of samples.
+        /** You should use this method to feed the activity from the digital signal processing. The covariance of the harmonics is accumulated over the window and published when the window is complete. The inputs matrix contains the harmonics samples with one row per harmonic (harmonics × vector size).
+         @param     vectorsize  The vector size.
+         @param     inputs      The inputs matrix.
+         @return    true if a covariance has been published, otherwise false.
+         */
+        virtual bool processBlock(const size_t vectorsize, const T* inputs) hoa_noexcept = 0;
+
+        //! This method performs the analysis of the last covariance.
+        /** You should use this method outside the digital signal processing, for example on a worker thread, to evaluate the power map and the peaks of the last covariance published by the processBlock method.
+         @return    true if a new covariance has been analyzed, otherwise false.
+         */
+        virtual bool analyze() hoa_noexcept = 0;
+
+        //! Retrieve the number of peaks.
+        /** Retrieve the number of peaks found by the last analysis, it is never greater than the maximum number of peaks.
+         @return    The number of peaks.
+         */
+        virtual size_t getNumberOfPeaks() const hoa_noexcept = 0;
+
+        //! Retrieve the azimuth of a peak.
+        /** Retrieve the azimuth of a peak refined between the points of the scope. The peaks are sorted from the strongest to the weakest.
+         @param     index   The index of the peak.
+         @return    The azimuth of the peak.
+         */
+        virtual T getPeakAzimuth(const size_t index) const hoa_noexcept = 0;
+
+        //! Retrieve the power of a peak.
+        /** Retrieve the steered response power of a peak refined between the points of the scope.
+         @param     index   The index of the peak.
+         @return    The power of the peak.
+         */
+        virtual T getPeakPower(const size_t index) const hoa_noexcept = 0;
+    };
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+    template <typename T> class Activity<Hoa2d, T> : public Processor<Hoa2d, T>::Harmonics
+    {
+    private:
+        Scope<Hoa2d, T> m_scope;
+        size_t      m_window;
+        size_t      m_count;
+        Buffer<T>   m_covariance;
+        Buffer<T>   m_factor;
+        Buffer<T>   m_power;
+        Buffer<T>   m_projection;
+        size_t      m_number_of_peaks;
+        size_t      m_maximum_of_peaks;
+        Buffer<T>   m_peaks_azimuth;
+        Buffer<T>   m_peaks_power;
+#if (__cplusplus > 199711L)
+        size_t      m_time;
+        Snapshot<T> m_snapshot;
+#else
+        bool        m_pending;
+        Buffer<T>   m_analyzed;
+#endif
+
+        //! Computes the power map.
+        /** The covariance is factorized with a Cholesky decomposition, the columns of the factor with a null pivot are ignored so a covariance of a few sources only needs a few projections. Each column is projected on the points with the scope and the power of a point is the sum of the squares of its projections.
+         */
+        void computePower(const T* covariance) hoa_noexcept
+        {
+            const size_t nharmonics = Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics();
+            const size_t npoints    = m_scope.getNumberOfPoints();
+            Signal<T>::clear(npoints, m_power);
+            T trace = 0;
+            for(size_t i = 0; i < nharmonics; i++)
+            {
+                trace += covariance[i * nharmonics + i];
+            }
+            const T threshold = trace * T(HOA_EPSILON);
+            for(size_t k = 0; k < nharmonics; k++)
+            {
+                T* column = m_factor + k * nharmonics;
+                T pivot = covariance[k * nharmonics + k];
+                for(size_t j = 0; j < k; j++)
+                {
+                    pivot -= m_factor[j * nharmonics + k] * m_factor[j * nharmonics + k];
+                }
+                Signal<T>::clear(nharmonics, column);
+                if(pivot <= threshold)
+                {
+                    continue;
+                }
+                const T diagonal = sqrt(pivot);
+                column[k] = diagonal;
+                for(size_t i = k + 1; i < nharmonics; i++)
+                {
+                    T value = covariance[i * nharmonics + k];
+                    for(size_t j = 0; j < k; j++)
+                    {
+                        value -= m_factor[j * nharmonics + i] * m_factor[j * nharmonics + k];
+                    }
+                    column[i] = value / diagonal;
+                }
+                m_scope.project(column, m_projection);
+                for(size_t i = 0; i < npoints; i++)
+                {
+                    m_power[i] += m_projection[i] * m_projection[i];
+                }
+            }
+        }
+
+        //! Computes the peaks.
+        /** The local maxima of the power map are sorted and their azimuths are refined with a parabolic interpolation of the power of the neighbour points.
+         */
+        void computePeaks() hoa_noexcept
+        {
+            const size_t npoints = m_scope.getNumberOfPoints();
+            m_number_of_peaks = 0;
+            for(size_t i = 0; i < npoints; i++)
+            {
+                const T previous = m_power[(i + npoints - 1) % npoints];
+                const T current  = m_power[i];
+                const T next     = m_power[(i + 1) % npoints];
+                // A plateau is only reported once by its first point.
+                if(current > 0. && current > previous && current >= next)
+                {
+                    const T offset = getOffset(previous, current, next);
+                    insertPeak(Math<T>::wrap_twopi(((T)i + offset) * HOA_2PI / (T)npoints), current - T(0.25) * (previous - next) * offset);
+                }
+            }
+        }
+
+        //! Retrieves the offset of the maximum of a parabola.
+        /** Retrieves the offset of the maximum of the parabola that passes through three consecutive values, between -0.5 and 0.5.
+         */
+        static inline T getOffset(const T previous, const T current, const T next) hoa_noexcept
+        {
+            const T curvature = previous - T(2.) * current + next;
+            if(curvature >= 0.)
+            {
+                return 0.;
+            }
+            const T offset = T(0.5) * (previous - next) / curvature;
+            return offset < -0.5 ? T(-0.5) : (offset > 0.5 ? T(0.5) : offset);
+        }
+
+        //! Inserts a peak.
+        /** Inserts a peak in the sorted peaks if it is stronger than the weakest one.
+         */
+        void insertPeak(const T azimuth, const T power) hoa_noexcept
+        {
+            size_t index = m_number_of_peaks < m_maximum_of_peaks ? m_number_of_peaks++ : m_maximum_of_peaks;
+            while(index > 0 && m_peaks_power[index - 1] < power)
+            {
+                if(index < m_maximum_of_peaks)
+                {
+                    m_peaks_azimuth[index] = m_peaks_azimuth[index - 1];
+                    m_peaks_power[index]   = m_peaks_power[index - 1];
+                }
+                index--;
+            }
+            if(index < m_maximum_of_peaks)
+            {
+                m_peaks_azimuth[index] = azimuth;
+                m_peaks_power[index]   = power;
+            }
+        }
+
+    public:
+
+        //! The activity constructor.
+        /**	The activity constructor allocates and initialize the member values to localize the sources on a circle depending on a order of decomposition, a circle discretization and a number of peaks. The order must be at least 1. The number of points should be at least 3 and should be greater than the number of harmonics to separate the sources.
+         @param     order            The order.
+         @param     numberOfPoints   The number of points.
+         @param     numberOfPeaks    The maximum number of peaks.
+         */
+        Activity(size_t order, size_t numberOfPoints, size_t numberOfPeaks) hoa_noexcept :
+        Processor<Hoa2d, T>::Harmonics(order),
+        m_scope(order, numberOfPoints),
+        m_window(4096),
+        m_count(0),
+        m_number_of_peaks(0),
+        m_maximum_of_peaks(numberOfPeaks)
+#if (__cplusplus > 199711L)
+        , m_time(0)
+        , m_snapshot(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics() * Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics())
+#endif
+        {
+            const size_t nharmonics = Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics();
+            m_covariance.resize(nharmonics * nharmonics);
+            m_factor.resize(nharmonics * nharmonics);
+            m_power.resize(numberOfPoints);
+            m_projection.resize(numberOfPoints);
+            m_peaks_azimuth.resize(numberOfPeaks);
+            m_peaks_power.resize(numberOfPeaks);
+            Signal<T>::clear(numberOfPoints, m_power);
+#if (__cplusplus <= 199711L)
+            m_pending = false;
+            m_analyzed.resize(nharmonics * nharmonics);
+#endif
+        }
+
+        //! Set the size of the window of the analysis.
+        /** Set the number of samples over which the covariance is accumulated, that defines the rate of the analysis, for example 4096 samples at 44.1 kHz for about 11 analysis per second. The current window is restarted.
+         @param     size   The number of samples of the window.
+         */
+        inline void setWindowSize(const size_t size) hoa_noexcept
+        {
+            m_window = size ? size : 1;
+            m_count = 0;
+        }
+
+        //! Get the size of the window of the analysis.
+        /** Get the number of samples over which the covariance is accumulated.
+         @return    The number of samples of the window.
+         */
+        inline size_t getWindowSize() const hoa_noexcept
+        {
+            return m_window;
+        }
+
+        //! This method accumulates the covariance of a block of samples.
+        /** You should use this method to feed the activity from the digital signal processing. The covariance of the harmonics is accumulated over the window and published when the window is complete, the cost only depends on the number of harmonics and not on the number of points. The inputs matrix contains the harmonics samples with one row per harmonic (harmonics × vector size).
+         @param     vectorsize  The vector size.
+         @param     inputs      The inputs matrix.
+         @return    true if a covariance has been published, otherwise false.
+         */
+        bool processBlock(const size_t vectorsize, const T* inputs) hoa_noexcept
+        {
+            const size_t nharmonics = Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics();
+            bool published = false;
+            size_t offset = 0;
+            while(offset < vectorsize)
+            {
+                if(m_count == 0)
+                {
+                    Signal<T>::clear(nharmonics * nharmonics, m_covariance);
+                }
+                const size_t size = (vectorsize - offset < m_window - m_count) ? vectorsize - offset : m_window - m_count;
+                for(size_t i = 0; i < nharmonics; i++)
+                {
+                    for(size_t j = i; j < nharmonics; j++)
+                    {
+                        m_covariance[i * nharmonics + j] += Signal<T>::dot(size, inputs + i * vectorsize + offset, inputs + j * vectorsize + offset);
+                    }
+                }
+                m_count += size;
+                offset  += size;
+#if (__cplusplus > 199711L)
+                m_time  += size;
+#endif
+                if(m_count == m_window)
+                {
+#if (__cplusplus > 199711L)
+                    T* covariance = m_snapshot.write();
+#else
+                    T* covariance = m_analyzed;
+#endif
+                    const T factor = T(1.) / T(m_window);
+                    for(size_t i = 0; i < nharmonics; i++)
+                    {
+                        for(size_t j = i; j < nharmonics; j++)
+                        {
+                            covariance[i * nharmonics + j] = covariance[j * nharmonics + i] = m_covariance[i * nharmonics + j] * factor;
+                        }
+                    }
+#if (__cplusplus > 199711L)
+                    m_snapshot.publish(m_time);
+#else
+                    m_pending = true;
+#endif
+                    m_count = 0;
+                    published = true;
+                }
+            }
+            return published;
+        }
+
+        //! This method performs the analysis of the last covariance.
+        /** You should use this method outside the digital signal processing, for example on a worker thread, to evaluate the power map and the peaks of the last covariance published by the processBlock method. The covariances published between two analysis are skipped. The power map and the peaks must only be retrieved by the thread that calls this method.
+         @return    true if a new covariance has been analyzed, otherwise false.
+         */
+        bool analyze() hoa_noexcept
+        {
+#if (__cplusplus > 199711L)
+            if(!m_snapshot.poll())
+            {
+                return false;
+            }
+            computePower(m_snapshot.read());
+#else
+            if(!m_pending)
+            {
+                return false;
+            }
+            m_pending = false;
+            computePower(m_analyzed);
+#endif
+            computePeaks();
+            return true;
+        }
+
+        //! Retrieve the number of points.
+        /**	Retrieve the number of points of the power map.
+         @return     The number of points.
+         */
+        inline size_t getNumberOfPoints() const hoa_noexcept
+        {
+            return m_scope.getNumberOfPoints();
+        }
+
+        //! Retrieve the power of a point.
+        /**	Retrieve the steered response power of a point of the power map computed by the last analysis.
+         @param     index   The index of the point.
+         @return    The power of the point.
+         */
+        inline T getPointPower(const size_t index) const hoa_noexcept
+        {
+            return m_power[index];
+        }
+
+        //! Retrieve the azimuth of a point.
+        /**	Retrieve the azimuth of a point of the power map.
+         @param     index   The index of the point.
+         @return    The azimuth of the point.
+         */
+        inline T getPointAzimuth(const size_t index) const hoa_noexcept
+        {
+            return m_scope.getPointAzimuth(index);
+        }
+
+        //! Retrieve the number of peaks.
+        /** Retrieve the number of peaks found by the last analysis, it is never greater than the maximum number of peaks.
+         @return    The number of peaks.
+         */
+        inline size_t getNumberOfPeaks() const hoa_noexcept
+        {
+            return m_number_of_peaks;
+        }
+
+        //! Retrieve the azimuth of a peak.
+        /** Retrieve the azimuth of a peak refined between the points of the power map. The peaks are sorted from the strongest to the weakest.
+         @param     index   The index of the peak.
+         @return    The azimuth of the peak.
+         */
+        inline T getPeakAzimuth(const size_t index) const hoa_noexcept
+        {
+            return m_peaks_azimuth[index];
+        }
+
+        //! Retrieve the power of a peak.
+        /** Retrieve the steered response power of a peak refined between the points of the power map.
+         @param     index   The index of the peak.
+         @return    The power of the peak.
+         */
+        inline T getPeakPower(const size_t index) const hoa_noexcept
+        {
+            return m_peaks_power[index];
+        }
+    };
+
+    template <typename T> class Activity<Hoa3d, T> : public Processor<Hoa3d, T>::Harmonics
+    {
+    private:
+        Scope<Hoa3d, T> m_scope;
+        size_t      m_window;
+        size_t      m_count;
+        Buffer<T>   m_covariance;
+        Buffer<T>   m_factor;
+        Buffer<T>   m_power;
+        Buffer<T>   m_projection;
+        size_t      m_number_of_peaks;
+        size_t      m_maximum_of_peaks;
+        Buffer<T>   m_peaks_azimuth;
+        Buffer<T>   m_peaks_elevation;
+        Buffer<T>   m_peaks_power;
+#if (__cplusplus > 199711L)
+        size_t      m_time;
+        Snapshot<T> m_snapshot;
+#else
+        bool        m_pending;
+        Buffer<T>   m_analyzed;
+#endif
+
+        //! Computes the power map.
+        /** The covariance is factorized with a Cholesky decomposition, the columns of the factor with a null pivot are ignored so a covariance of a few sources only needs a few projections. Each column is projected on the points with the scope and the power of a point is the sum of the squares of its projections.
+         */
+        void computePower(const T* covariance) hoa_noexcept
+        {
+            const size_t nharmonics = Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics();
+            const size_t nrows      = m_scope.getNumberOfRows();
+            const size_t ncolumns   = m_scope.getNumberOfColumns();
+            Signal<T>::clear(nrows * ncolumns, m_power);
+            T trace = 0;
+            for(size_t i = 0; i < nharmonics; i++)
+            {
+                trace += covariance[i * nharmonics + i];
+            }
+            const T threshold = trace * T(HOA_EPSILON);
+            for(size_t k = 0; k < nharmonics; k++)
+            {
+                T* column = m_factor + k * nharmonics;
+                T pivot = covariance[k * nharmonics + k];
+                for(size_t j = 0; j < k; j++)
+                {
+                    pivot -= m_factor[j * nharmonics + k] * m_factor[j * nharmonics + k];
+                }
+                Signal<T>::clear(nharmonics, column);
+                if(pivot <= threshold)
+                {
+                    continue;
+                }
+                const T diagonal = sqrt(pivot);
+                column[k] = diagonal;
+                for(size_t i = k + 1; i < nharmonics; i++)
+                {
+                    T value = covariance[i * nharmonics + k];
+                    for(size_t j = 0; j < k; j++)
+                    {
+                        value -= m_factor[j * nharmonics + i] * m_factor[j * nharmonics + k];
+                    }
+                    column[i] = value / diagonal;
+                }
+                m_scope.project(column, m_projection);
+                for(size_t i = 0; i < nrows * ncolumns; i++)
+                {
+                    m_power[i] += m_projection[i] * m_projection[i];
+                }
+            }
+        }
+
+        //! Computes the peaks.
+        /** The local maxima of the power map are sorted and their azimuths and elevations are refined with a parabolic interpolation of the power of the neighbour points. The points of a pole share the same direction so only the first one is tested against the points of the next row.
+         */
+        void computePeaks() hoa_noexcept
+        {
+            const size_t nrows    = m_scope.getNumberOfRows();
+            const size_t ncolumns = m_scope.getNumberOfColumns();
+            const T step = HOA_PI / (T)(nrows - 1);
+            m_number_of_peaks = 0;
+            for(size_t p = 0; p < 2; p++)
+            {
+                const T* pole = m_power + (p ? (nrows - 1) * ncolumns : 0);
+                const T* next = m_power + (p ? (nrows - 2) * ncolumns : ncolumns);
+                bool maximum = pole[0] > 0.;
+                for(size_t j = 0; j < ncolumns && maximum; j++)
+                {
+                    maximum = pole[0] > next[j];
+                }
+                if(maximum)
+                {
+                    insertPeak(0., p ? T(HOA_PI2) : T(-HOA_PI2), pole[0]);
+                }
+            }
+            for(size_t i = 1; i < nrows - 1; i++)
+            {
+                const T* below = m_power + (i - 1) * ncolumns;
+                const T* row   = m_power + i * ncolumns;
+                const T* above = m_power + (i + 1) * ncolumns;
+                for(size_t j = 0; j < ncolumns; j++)
+                {
+                    const size_t left  = (j + ncolumns - 1) % ncolumns;
+                    const size_t right = (j + 1) % ncolumns;
+                    const T current = row[j];
+                    // A plateau is only reported once by its first point.
+                    if(current > 0. && current > row[left] && current >= row[right]
+                       && current > below[left] && current > below[j] && current > below[right]
+                       && current >= above[left] && current >= above[j] && current >= above[right])
+                    {
+                        const T azimuth   = getOffset(row[left], current, row[right]);
+                        const T elevation = getOffset(below[j], current, above[j]);
+                        const T power     = current - T(0.25) * (row[left] - row[right]) * azimuth - T(0.25) * (below[j] - above[j]) * elevation;
+                        insertPeak(Math<T>::wrap_twopi(((T)j + azimuth) * HOA_2PI / (T)ncolumns), ((T)i + elevation) * step - HOA_PI2, power);
+                    }
+                }
+            }
+        }
+
+        //! Retrieves the offset of the maximum of a parabola.
+        /** Retrieves the offset of the maximum of the parabola that passes through three consecutive values, between -0.5 and 0.5.
+         */
+        static inline T getOffset(const T previous, const T current, const T next) hoa_noexcept
+        {
+            const T curvature = previous - T(2.) * current + next;
+            if(curvature >= 0.)
+            {
+                return 0.;
+            }
+            const T offset = T(0.5) * (previous - next) / curvature;
+            return offset < -0.5 ? T(-0.5) : (offset > 0.5 ? T(0.5) : offset);
+        }
+
+        //! Inserts a peak.
+        /** Inserts a peak in the sorted peaks if it is stronger than the weakest one.
+         */
+        void insertPeak(const T azimuth, const T elevation, const T power) hoa_noexcept
+        {
+            size_t index = m_number_of_peaks < m_maximum_of_peaks ? m_number_of_peaks++ : m_maximum_of_peaks;
+            while(index > 0 && m_peaks_power[index - 1] < power)
+            {
+                if(index < m_maximum_of_peaks)
+                {
+                    m_peaks_azimuth[index]   = m_peaks_azimuth[index - 1];
+                    m_peaks_elevation[index] = m_peaks_elevation[index - 1];
+                    m_peaks_power[index]     = m_peaks_power[index - 1];
+                }
+                index--;
+            }
+            if(index < m_maximum_of_peaks)
+            {
+                m_peaks_azimuth[index]   = azimuth;
+                m_peaks_elevation[index] = elevation;
+                m_peaks_power[index]     = power;
+            }
+        }
+
+    public:
+
+        //! The activity constructor.
+        /**	The activity constructor allocates and initialize the member values to localize the sources on a sphere depending on a order of decomposition, a sphere discretization and a number of peaks. The sphere is discretized by rows and columns like the scope. The order must be at least 1. The number of rows and columns should be at least 3.
+         @param     order            The order.
+         @param     numberOfRows     The number of rows.
+         @param     numberOfColumns  The number of columns.
+         @param     numberOfPeaks    The maximum number of peaks.
+         */
+        Activity(size_t order, size_t numberOfRows, size_t numberOfColumns, size_t numberOfPeaks) hoa_noexcept :
+        Processor<Hoa3d, T>::Harmonics(order),
+        m_scope(order, numberOfRows, numberOfColumns),
+        m_window(4096),
+        m_count(0),
+        m_number_of_peaks(0),
+        m_maximum_of_peaks(numberOfPeaks)
+#if (__cplusplus > 199711L)
+        , m_time(0)
+        , m_snapshot(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics() * Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics())
+#endif
+        {
+            const size_t nharmonics = Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics();
+            m_covariance.resize(nharmonics * nharmonics);
+            m_factor.resize(nharmonics * nharmonics);
+            m_power.resize(numberOfRows * numberOfColumns);
+            m_projection.resize(numberOfRows * numberOfColumns);
+            m_peaks_azimuth.resize(numberOfPeaks);
+            m_peaks_elevation.resize(numberOfPeaks);
+            m_peaks_power.resize(numberOfPeaks);
+            Signal<T>::clear(numberOfRows * numberOfColumns, m_power);
+#if (__cplusplus <= 199711L)
+            m_pending = false;
+            m_analyzed.resize(nharmonics * nharmonics);
+#endif
+        }
+
+        //! Set the size of the window of the analysis.
+        /** Set the number of samples over which the covariance is accumulated, that defines the rate of the analysis, for example 4096 samples at 44.1 kHz for about 11 analysis per second. The current window is restarted.
+         @param     size   The number of samples of the window.
+         */
+        inline void setWindowSize(const size_t size) hoa_noexcept
+        {
+            m_window = size ? size : 1;
+            m_count = 0;
+        }
+
+        //! Get the size of the window of the analysis.
+        /** Get the number of samples over which the covariance is accumulated.
+         @return    The number of samples of the window.
+         */
+        inline size_t getWindowSize() const hoa_noexcept
+        {
+            return m_window;
+        }
+
+        //! This method accumulates the covariance of a block of samples.
+        /** You should use this method to feed the activity from the digital signal processing. The covariance of the harmonics is accumulated over the window and published when the window is complete, the cost only depends on the number of harmonics and not on the number of points. The inputs matrix contains the harmonics samples with one row per harmonic (harmonics × vector size).
+         @param     vectorsize  The vector size.
+         @param     inputs      The inputs matrix.
+         @return    true if a covariance has been published, otherwise false.
+         */
+        bool processBlock(const size_t vectorsize, const T* inputs) hoa_noexcept
+        {
+            const size_t nharmonics = Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics();
+            bool published = false;
+            size_t offset = 0;
+            while(offset < vectorsize)
+            {
+                if(m_count == 0)
+                {
+                    Signal<T>::clear(nharmonics * nharmonics, m_covariance);
+                }
+                const size_t size = (vectorsize - offset < m_window - m_count) ? vectorsize - offset : m_window - m_count;
+                for(size_t i = 0; i < nharmonics; i++)
+                {
+                    for(size_t j = i; j < nharmonics; j++)
+                    {
+                        m_covariance[i * nharmonics + j] += Signal<T>::dot(size, inputs + i * vectorsize + offset, inputs + j * vectorsize + offset);
+                    }
+                }
+                m_count += size;
+                offset  += size;
+#if (__cplusplus > 199711L)
+                m_time  += size;
+#endif
+                if(m_count == m_window)
+                {
+#if (__cplusplus > 199711L)
+                    T* covariance = m_snapshot.write();
+#else
+                    T* covariance = m_analyzed;
+#endif
+                    const T factor = T(1.) / T(m_window);
+                    for(size_t i = 0; i < nharmonics; i++)
+                    {
+                        for(size_t j = i; j < nharmonics; j++)
+                        {
+                            covariance[i * nharmonics + j] = covariance[j * nharmonics + i] = m_covariance[i * nharmonics + j] * factor;
+                        }
+                    }
+#if (__cplusplus > 199711L)
+                    m_snapshot.publish(m_time);
+#else
+                    m_pending = true;
+#endif
+                    m_count = 0;
+                    published = true;
+                }
+            }
+            return published;
+        }
+
+        //! This method performs the analysis of the last covariance.
+        /** You should use this method outside the digital signal processing, for example on a worker thread, to evaluate the power map and the peaks of the last covariance published by the processBlock method. The covariances published between two analysis are skipped. The power map and the peaks must only be retrieved by the thread that calls this method.
+         @return    true if a new covariance has been analyzed, otherwise false.
+         */
+        bool analyze() hoa_noexcept
+        {
+#if (__cplusplus > 199711L)
+            if(!m_snapshot.poll())
+            {
+                return false;
+            }
+            computePower(m_snapshot.read());
+#else
+            if(!m_pending)
+            {
+                return false;
+            }
+            m_pending = false;
+            computePower(m_analyzed);
+#endif
+            computePeaks();
+            return true;
+        }
+
+        //! Retrieve the number of rows.
+        /**	Retrieve the number of rows of the power map.
+         @return     The number of rows.
+         */
+        inline size_t getNumberOfRows() const hoa_noexcept
+        {
+            return m_scope.getNumberOfRows();
+        }
+
+        //! Retrieve the number of columns.
+        /**	Retrieve the number of columns of the power map.
+         @return     The number of columns.
+         */
+        inline size_t getNumberOfColumns() const hoa_noexcept
+        {
+            return m_scope.getNumberOfColumns();
+        }
+
+        //! Retrieve the power of a point.
+        /**	Retrieve the steered response power of a point of the power map computed by the last analysis. For the row index, 0 is the bottom of the sphere and number of rows - 1 is the top of the sphere. For the column index, 0 is the front (0 radian).
+         @param     rowIndex     The row index of the point.
+         @param     columnIndex  The column index of the point.
+         @return    The power of the point.
+         */
+        inline T getPointPower(const size_t rowIndex, const size_t columnIndex) const hoa_noexcept
+        {
+            return m_power[rowIndex * m_scope.getNumberOfColumns() + columnIndex];
+        }
+
+        //! Retrieve the azimuth of a column.
+        /**	Retrieve the azimuth of a column of the power map.
+         @param     columnIndex  The column index of the point.
+         @return    The azimuth of the column.
+         */
+        inline T getPointAzimuth(const size_t columnIndex) const hoa_noexcept
+        {
+            return m_scope.getPointAzimuth(columnIndex);
+        }
+
+        //! Retrieve the elevation of a row.
+        /**	Retrieve the elevation of a row of the power map.
+         @param     rowIndex     The row index of the point.
+         @return    The elevation of the row.
+         */
+        inline T getPointElevation(const size_t rowIndex) const hoa_noexcept
+        {
+            return m_scope.getPointElevation(rowIndex);
+        }
+
+        //! Retrieve the number of peaks.
+        /** Retrieve the number of peaks found by the last analysis, it is never greater than the maximum number of peaks.
+         @return    The number of peaks.
+         */
+        inline size_t getNumberOfPeaks() const hoa_noexcept
+        {
+            return m_number_of_peaks;
+        }
+
+        //! Retrieve the azimuth of a peak.
+        /** Retrieve the azimuth of a peak refined between the points of the power map. The peaks are sorted from the strongest to the weakest.
+         @param     index   The index of the peak.
+         @return    The azimuth of the peak.
+         */
+        inline T getPeakAzimuth(const size_t index) const hoa_noexcept
+        {
+            return m_peaks_azimuth[index];
+        }
+
+        //! Retrieve the elevation of a peak.
+        /** Retrieve the elevation of a peak refined between the points of the power map. The peaks are sorted from the strongest to the weakest.
+         @param     index   The index of the peak.
+         @return    The elevation of the peak.
+         */
+        inline T getPeakElevation(const size_t index) const hoa_noexcept
+        {
+            return m_peaks_elevation[index];
+        }
+
+        //! Retrieve the power of a peak.
+        /** Retrieve the steered response power of a peak refined between the points of the power map.
+         @param     index   The index of the peak.
+         @return    The power of the peak.
+         */
+        inline T getPeakPower(const size_t index) const hoa_noexcept
+        {
+            return m_peaks_power[index];
+        }
+    };
+
+#endif
+
+}
+
+#endif
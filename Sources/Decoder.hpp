@@ -9,6 +9,7 @@
 
 #include "Encoder.hpp"
 #include "Hrir.hpp"
+#include "Fft.hpp"
 
 namespace hoa
 {
@@ -121,7 +122,6 @@ namespace hoa
              */
             Binaural(const size_t order);
 
-
             //! The binaural decoder destructor.
             /**	The binaural decoder destructor free the memory.
              */
@@ -170,14 +170,6 @@ namespace hoa
             ;
         }
 
-        //! The destructor.
-        /** The destructor free the memory.
-         */
-        virtual ~Decoder()
-        {
-            ;
-        }
-
         //! This method performs the decoding.
         /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics and the outputs array contains the channels samples and the minimum size must be the number of channels.
          @param     inputs  The input array that contains the samples of the harmonics.
@@ -216,7 +208,8 @@ namespace hoa
     template <typename T> class Decoder<Hoa2d, T>::Regular : public Decoder<Hoa2d, T>
     {
     private:
-        T*  m_matrix;
+        Buffer<T> m_matrix;
+        FftProjection<T> m_fft;
     public:
 
         //! The regular constructor.
@@ -226,18 +219,10 @@ namespace hoa
          */
         Regular(const size_t order, const size_t numberOfPlanewaves) hoa_noexcept : Decoder<Hoa2d, T>(order, numberOfPlanewaves)
         {
-            m_matrix = Signal<T>::alloc(Decoder<Hoa2d, T>::getNumberOfPlanewaves() * Decoder<Hoa2d, T>::getNumberOfHarmonics());
+            m_matrix.resize(Decoder<Hoa2d, T>::getNumberOfPlanewaves() * Decoder<Hoa2d, T>::getNumberOfHarmonics());
             computeRendering();
         }
 
-        //! The destructor.
-        /** The destructor free the memory.
-         */
-        ~Regular()
-        {
-            Signal<T>::free(m_matrix);
-        }
-
         //! This method retrives the mode of the decoder.
         /**	This method retrives the mode of the decoder.
          @retun The mode of the decoder.
@@ -251,7 +236,51 @@ namespace hoa
          */
         inline void process(const T* inputs, T* outputs) hoa_noexcept hoa_override
         {
-            Signal<T>::mul(Decoder<Hoa2d, T>::getNumberOfHarmonics(), Decoder<Hoa2d, T>::getNumberOfPlanewaves(), inputs, m_matrix, outputs);
+            if(Signal<T>::isZero(Decoder<Hoa2d, T>::getNumberOfHarmonics(), inputs))
+            {
+                Signal<T>::clear(Decoder<Hoa2d, T>::getNumberOfPlanewaves(), outputs);
+                return;
+            }
+            if(m_fft.isEnabled())
+            {
+                m_fft.process(inputs, outputs);
+            }
+            else
+            {
+                Signal<T>::mul(Decoder<Hoa2d, T>::getNumberOfHarmonics(), Decoder<Hoa2d, T>::getNumberOfPlanewaves(), inputs, m_matrix, outputs);
+            }
+        }
+
+        //! This method performs the decoding of several sound fields that share the same configuration.
+        /**	You should use this method for not-in-place processing of several sound fields (or scenes) that use the same decoding matrix. The scenes are decoded together with a single matrix product. The inputs matrix contains the harmonics samples with one row per harmonic, each row holds the vectors of the scenes one after the other (harmonics × (number of scenes × vector size)). The outputs matrix contains the channels samples with the same layout (channels × (number of scenes × vector size)).
+         @param     nscenes     The number of scenes.
+         @param     vectorsize  The vector size of each scene.
+         @param     inputs      The input matrix that contains the samples of the harmonics.
+         @param     outputs     The output matrix that contains samples destinated to channels.
+         */
+        inline void processBlock(const size_t nscenes, const size_t vectorsize, const T* inputs, T* outputs) hoa_noexcept
+        {
+            if(Signal<T>::isZero(Decoder<Hoa2d, T>::getNumberOfHarmonics() * nscenes * vectorsize, inputs))
+            {
+                Signal<T>::clear(Decoder<Hoa2d, T>::getNumberOfPlanewaves() * nscenes * vectorsize, outputs);
+                return;
+            }
+            processBlock(nscenes, vectorsize, inputs, outputs, 0ul, Decoder<Hoa2d, T>::getNumberOfPlanewaves());
+        }
+
+        //! This method performs the decoding of several sound fields for a range of channels.
+        /**	You should use this method to share the decoding of a large number of channels between several threads. Each call only reads the rows of the decoding matrix and only writes the rows of the outputs matrix that belong to the range of channels, so the threads can work on the same inputs and outputs matrices at the same time. The layout of the matrices is the same as for the batched decoding. The silent inputs are not bypassed, the caller should test them once for the whole block instead of once per range. To avoid false sharing, the size of a row (number of scenes × vector size) should be a multiple of a cache line. With C++11, the workers class shares the ranges of a block between a pool of threads.
+         @param     nscenes     The number of scenes.
+         @param     vectorsize  The vector size of each scene.
+         @param     inputs      The input matrix that contains the samples of the harmonics.
+         @param     outputs     The output matrix that contains samples destinated to channels.
+         @param     first       The index of the first channel of the range.
+         @param     count       The number of channels of the range.
+         */
+        inline void processBlock(const size_t nscenes, const size_t vectorsize, const T* inputs, T* outputs, const size_t first, const size_t count) hoa_noexcept
+        {
+            const size_t nharmonics = Decoder<Hoa2d, T>::getNumberOfHarmonics();
+            Signal<T>::mul(count, nscenes * vectorsize, nharmonics, m_matrix + first * nharmonics, inputs, outputs + first * nscenes * vectorsize);
         }
 
         //! This method computes the decoding matrix.
@@ -268,13 +297,14 @@ namespace hoa
                 encoder.process(&factor, m_matrix + i * Decoder<Hoa2d, T>::getNumberOfHarmonics());
                 m_matrix[i * encoder.getNumberOfHarmonics()] = factor * 0.5;
             }
+            m_fft.compute(Decoder<Hoa2d, T>::getDecompositionOrder(), Decoder<Hoa2d, T>::getNumberOfPlanewaves(), m_matrix);
         }
     };
 
     template <typename T> class Decoder<Hoa2d, T>::Irregular : public Decoder<Hoa2d, T>
     {
     private:
-        T*  m_matrix;
+        Buffer<T> m_matrix;
     public:
 
         //! The irregular constructor.
@@ -284,18 +314,10 @@ namespace hoa
          */
         Irregular(const size_t order, const size_t numberOfPlanewaves) hoa_noexcept : Decoder<Hoa2d, T>(order, numberOfPlanewaves)
         {
-            m_matrix = Signal<T>::alloc(Decoder<Hoa2d, T>::getNumberOfPlanewaves() * Decoder<Hoa2d, T>::getNumberOfHarmonics());
+            m_matrix.resize(Decoder<Hoa2d, T>::getNumberOfPlanewaves() * Decoder<Hoa2d, T>::getNumberOfHarmonics());
             computeRendering();
         }
 
-        //! The destructor.
-        /** The destructor free the memory.
-         */
-        ~Irregular()
-        {
-            Signal<T>::free(m_matrix);
-        }
-
         //! This method retrives the mode of the decoder.
         /**	This method retrives the mode of the decoder.
          @retun The mode of the decoder.
@@ -309,9 +331,46 @@ namespace hoa
          */
         inline void process(const T* inputs, T* outputs) hoa_noexcept hoa_override
         {
+            if(Signal<T>::isZero(Decoder<Hoa2d, T>::getNumberOfHarmonics(), inputs))
+            {
+                Signal<T>::clear(Decoder<Hoa2d, T>::getNumberOfPlanewaves(), outputs);
+                return;
+            }
             Signal<T>::mul(Decoder<Hoa2d, T>::getNumberOfHarmonics(), Decoder<Hoa2d, T>::getNumberOfPlanewaves(), inputs, m_matrix, outputs);
         }
 
+        //! This method performs the decoding of several sound fields that share the same configuration.
+        /**	You should use this method for not-in-place processing of several sound fields (or scenes) that use the same decoding matrix. The scenes are decoded together with a single matrix product. The inputs matrix contains the harmonics samples with one row per harmonic, each row holds the vectors of the scenes one after the other (harmonics × (number of scenes × vector size)). The outputs matrix contains the channels samples with the same layout (channels × (number of scenes × vector size)).
+         @param     nscenes     The number of scenes.
+         @param     vectorsize  The vector size of each scene.
+         @param     inputs      The input matrix that contains the samples of the harmonics.
+         @param     outputs     The output matrix that contains samples destinated to channels.
+         */
+        inline void processBlock(const size_t nscenes, const size_t vectorsize, const T* inputs, T* outputs) hoa_noexcept
+        {
+            if(Signal<T>::isZero(Decoder<Hoa2d, T>::getNumberOfHarmonics() * nscenes * vectorsize, inputs))
+            {
+                Signal<T>::clear(Decoder<Hoa2d, T>::getNumberOfPlanewaves() * nscenes * vectorsize, outputs);
+                return;
+            }
+            processBlock(nscenes, vectorsize, inputs, outputs, 0ul, Decoder<Hoa2d, T>::getNumberOfPlanewaves());
+        }
+
+        //! This method performs the decoding of several sound fields for a range of channels.
+        /**	You should use this method to share the decoding of a large number of channels between several threads. Each call only reads the rows of the decoding matrix and only writes the rows of the outputs matrix that belong to the range of channels, so the threads can work on the same inputs and outputs matrices at the same time. The layout of the matrices is the same as for the batched decoding. The silent inputs are not bypassed, the caller should test them once for the whole block instead of once per range. To avoid false sharing, the size of a row (number of scenes × vector size) should be a multiple of a cache line. With C++11, the workers class shares the ranges of a block between a pool of threads.
+         @param     nscenes     The number of scenes.
+         @param     vectorsize  The vector size of each scene.
+         @param     inputs      The input matrix that contains the samples of the harmonics.
+         @param     outputs     The output matrix that contains samples destinated to channels.
+         @param     first       The index of the first channel of the range.
+         @param     count       The number of channels of the range.
+         */
+        inline void processBlock(const size_t nscenes, const size_t vectorsize, const T* inputs, T* outputs, const size_t first, const size_t count) hoa_noexcept
+        {
+            const size_t nharmonics = Decoder<Hoa2d, T>::getNumberOfHarmonics();
+            Signal<T>::mul(count, nscenes * vectorsize, nharmonics, m_matrix + first * nharmonics, inputs, outputs + first * nscenes * vectorsize);
+        }
+
         //! This method computes the decoding matrix.
         /**	You should use this method after changing the position of the loudspeakers.
          @param vectorsize The vector size for binaural decoding.
@@ -470,17 +529,18 @@ namespace hoa
     private:
         size_t       m_vector_size;
         size_t       m_crop_size;
-        T*          m_input;
-        T*          m_result;
-        T*          m_left;
-        T*          m_right;
+        size_t       m_tail;
+        Buffer<T>    m_input;
+        Buffer<T>    m_result;
+        Buffer<T>    m_left;
+        Buffer<T>    m_right;
 
         void clear()
         {
-            m_input  = Signal<T>::free(m_input);
-            m_result = Signal<T>::free(m_result);
-            m_left   = Signal<T>::free(m_left);
-            m_right  = Signal<T>::free(m_right);
+            m_input.resize(0ul);
+            m_result.resize(0ul);
+            m_left.resize(0ul);
+            m_right.resize(0ul);
         }
     public:
 
@@ -490,10 +550,7 @@ namespace hoa
          */
         Binaural(const size_t order) hoa_noexcept : Decoder<Hoa2d, T>(order, 2),
         m_vector_size(0ul),
-        m_input(hoa_nullptr),
-        m_result(hoa_nullptr),
-        m_left(hoa_nullptr),
-        m_right(hoa_nullptr)
+        m_tail(0ul)
         {
             Decoder<Hoa2d, T>::setPlanewaveAzimuth(0, (T)(HOA_PI2*3.));
             Decoder<Hoa2d, T>::setPlanewaveAzimuth(1, (T)(HOA_PI2));
@@ -506,14 +563,6 @@ namespace hoa
          */
         inline Mode getMode() const hoa_noexcept hoa_override {return BinauralMode;};
 
-        //! The binaural decoder destructor.
-        /**	The binaural decoder destructor free the memory.
-         */
-        ~Binaural() hoa_noexcept
-        {
-            clear();
-        }
-
         //! This method sets the crop size of the responses.
         /**	This method sets the crop size of the responses.
          @param size The crop size.
@@ -550,10 +599,11 @@ namespace hoa
         {
             clear();
             m_vector_size  = vectorsize;
-            m_input  = Signal<T>::alloc(Hrir<Hoa2d, T>::getNumberOfColumns() * m_vector_size);
-            m_result = Signal<T>::alloc(Hrir<Hoa2d, T>::getNumberOfRows() * m_vector_size);
-            m_left   = Signal<T>::alloc(Hrir<Hoa2d, T>::getNumberOfRows() + m_vector_size);
-            m_right  = Signal<T>::alloc(Hrir<Hoa2d, T>::getNumberOfRows() + m_vector_size);
+            m_tail         = 0ul;
+            m_input.resize(Hrir<Hoa2d, T>::getNumberOfColumns() * m_vector_size);
+            m_result.resize(Hrir<Hoa2d, T>::getNumberOfRows() * m_vector_size);
+            m_left.resize(Hrir<Hoa2d, T>::getNumberOfRows() + m_vector_size);
+            m_right.resize(Hrir<Hoa2d, T>::getNumberOfRows() + m_vector_size);
         }
 
     private:
@@ -567,15 +617,46 @@ namespace hoa
             {
                 Signal<T>::add(m, m_result + i, n, vector + i, 1ul);
             }
+            processTail(vector, output);
+        }
+
+        inline void processTail(T* vector, T* output) hoa_noexcept
+        {
             Signal<T>::copy(m_vector_size, vector, output);
-            Signal<T>::copy(m, vector + m_vector_size, vector);
-            Signal<T>::clear(m_vector_size, vector + m);
+            Signal<T>::move(m_crop_size, vector + m_vector_size, vector);
+            Signal<T>::clear(m_vector_size, vector + m_crop_size);
         }
     public:
 
         //! This method performs the binaural decoding and the convolution.
+        /**	You should use this method for not-in-place processing of a block of samples. The inputs array contains the harmonics vectors and the outputs array contains the headphones vectors. When the inputs are silent, the convolution is skipped and only the remaining tail of the previous responses is written to the outputs until it has decayed.
+         @param     inputs	The input vectors.
+         @param     outputs  The output vectors.
+         */
         inline void processBlock(const T** inputs, T** outputs) hoa_noexcept
         {
+            bool silent = true;
+            for(size_t i = 0; i < Hrir<Hoa2d, T>::getNumberOfColumns() && i < Decoder<Hoa2d, T>::getNumberOfHarmonics() && silent; i++)
+            {
+                silent = Signal<T>::isZero(m_vector_size, inputs[i]);
+            }
+            if(silent)
+            {
+                if(m_tail)
+                {
+                    processTail(m_left, outputs[0]);
+                    processTail(m_right, outputs[1]);
+                    m_tail = (m_tail > m_vector_size) ? m_tail - m_vector_size : 0ul;
+                }
+                else
+                {
+                    Signal<T>::clear(m_vector_size, outputs[0]);
+                    Signal<T>::clear(m_vector_size, outputs[1]);
+                }
+                return;
+            }
+            m_tail = m_crop_size;
+
             T* input = m_input;
             for(size_t i = 0; i < Hrir<Hoa2d, T>::getNumberOfColumns() && i < Decoder<Hoa2d, T>::getNumberOfHarmonics(); i++)
             {
@@ -612,14 +693,6 @@ namespace hoa
             ;
         }
 
-        //! The destructor.
-        /** The destructor free the memory.
-         */
-        virtual ~Decoder()
-        {
-            ;
-        }
-
         //! This method retrives the mode of the decoder.
         /**	This method retrives the mode of the decoder.
          @retun The mode of the decoder.
@@ -653,7 +726,7 @@ namespace hoa
     template <typename T> class Decoder<Hoa3d, T>::Regular : public Decoder<Hoa3d, T>
     {
     private:
-        T*  m_matrix;
+        Buffer<T> m_matrix;
     public:
 
         //! The regular constructor.
@@ -663,7 +736,7 @@ namespace hoa
          */
         Regular(const size_t order, const size_t numberOfPlanewaves) hoa_noexcept : Decoder<Hoa3d, T>(order, numberOfPlanewaves)
         {
-            m_matrix = Signal<T>::alloc(Decoder<Hoa3d, T>::getNumberOfPlanewaves() * Decoder<Hoa3d, T>::getNumberOfHarmonics());
+            m_matrix.resize(Decoder<Hoa3d, T>::getNumberOfPlanewaves() * Decoder<Hoa3d, T>::getNumberOfHarmonics());
             computeRendering();
         }
 
@@ -673,14 +746,6 @@ namespace hoa
          */
         inline Mode getMode() const hoa_noexcept hoa_override {return RegularMode;};
 
-        //! The regular destructor.
-        /**	The regular destructor free the memory.
-         */
-        ~Regular()
-        {
-            Signal<T>::free(m_matrix);
-        }
-
         //! This method performs the decoding.
         /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics and the outputs array contains the channels samples and the minimum size must be the number of channels.
          @param     inputs  The input array that contains the samples of the harmonics.
@@ -688,9 +753,46 @@ namespace hoa
          */
         inline void process(const T* inputs, T* outputs) hoa_noexcept hoa_override
         {
+            if(Signal<T>::isZero(Decoder<Hoa3d, T>::getNumberOfHarmonics(), inputs))
+            {
+                Signal<T>::clear(Decoder<Hoa3d, T>::getNumberOfPlanewaves(), outputs);
+                return;
+            }
             Signal<T>::mul(Decoder<Hoa3d, T>::getNumberOfHarmonics(), Decoder<Hoa3d, T>::getNumberOfPlanewaves(), inputs, m_matrix, outputs);
         }
 
+        //! This method performs the decoding of several sound fields that share the same configuration.
+        /**	You should use this method for not-in-place processing of several sound fields (or scenes) that use the same decoding matrix. The scenes are decoded together with a single matrix product. The inputs matrix contains the harmonics samples with one row per harmonic, each row holds the vectors of the scenes one after the other (harmonics × (number of scenes × vector size)). The outputs matrix contains the channels samples with the same layout (channels × (number of scenes × vector size)).
+         @param     nscenes     The number of scenes.
+         @param     vectorsize  The vector size of each scene.
+         @param     inputs      The input matrix that contains the samples of the harmonics.
+         @param     outputs     The output matrix that contains samples destinated to channels.
+         */
+        inline void processBlock(const size_t nscenes, const size_t vectorsize, const T* inputs, T* outputs) hoa_noexcept
+        {
+            if(Signal<T>::isZero(Decoder<Hoa3d, T>::getNumberOfHarmonics() * nscenes * vectorsize, inputs))
+            {
+                Signal<T>::clear(Decoder<Hoa3d, T>::getNumberOfPlanewaves() * nscenes * vectorsize, outputs);
+                return;
+            }
+            processBlock(nscenes, vectorsize, inputs, outputs, 0ul, Decoder<Hoa3d, T>::getNumberOfPlanewaves());
+        }
+
+        //! This method performs the decoding of several sound fields for a range of channels.
+        /**	You should use this method to share the decoding of a large number of channels between several threads. Each call only reads the rows of the decoding matrix and only writes the rows of the outputs matrix that belong to the range of channels, so the threads can work on the same inputs and outputs matrices at the same time. The layout of the matrices is the same as for the batched decoding. The silent inputs are not bypassed, the caller should test them once for the whole block instead of once per range. To avoid false sharing, the size of a row (number of scenes × vector size) should be a multiple of a cache line. With C++11, the workers class shares the ranges of a block between a pool of threads.
+         @param     nscenes     The number of scenes.
+         @param     vectorsize  The vector size of each scene.
+         @param     inputs      The input matrix that contains the samples of the harmonics.
+         @param     outputs     The output matrix that contains samples destinated to channels.
+         @param     first       The index of the first channel of the range.
+         @param     count       The number of channels of the range.
+         */
+        inline void processBlock(const size_t nscenes, const size_t vectorsize, const T* inputs, T* outputs, const size_t first, const size_t count) hoa_noexcept
+        {
+            const size_t nharmonics = Decoder<Hoa3d, T>::getNumberOfHarmonics();
+            Signal<T>::mul(count, nscenes * vectorsize, nharmonics, m_matrix + first * nharmonics, inputs, outputs + first * nscenes * vectorsize);
+        }
+
         //! This method computes the decoding matrix.
         /**	You should use this method after changing the position of the loudspeakers.
          @param vectorsize The vector size for binaural decoding.
@@ -698,25 +800,27 @@ namespace hoa
         void computeRendering(const size_t vectorsize = 64)  hoa_override
         {
             typename Encoder<Hoa3d, T>::Basic encoder(Decoder<Hoa3d, T>::getDecompositionOrder());
+            const size_t nharmonics = Decoder<Hoa3d, T>::getNumberOfHarmonics();
+            const size_t* degrees   = Decoder<Hoa3d, T>::getHarmonicTable().getDegrees();
+            const long* orders      = Decoder<Hoa3d, T>::getHarmonicTable().getOrders();
+            T* weights = Signal<T>::alloc(nharmonics);
+            for(size_t j = 0; j < nharmonics; j++)
+            {
+                weights[j] = (orders[j] == 0) ? T(2. * degrees[j] + 1.) : T(2. * degrees[j] + 1.) * T(4. * HOA_PI);
+            }
             const T factor = 1. / (T)(Decoder<Hoa3d, T>::getNumberOfPlanewaves());
             for(size_t i = 0; i < Decoder<Hoa3d, T>::getNumberOfPlanewaves(); i++)
             {
+                T* row = m_matrix + i * nharmonics;
                 encoder.setAzimuth(Decoder<Hoa3d, T>::getPlanewaveAzimuth(i));
                 encoder.setElevation(Decoder<Hoa3d, T>::getPlanewaveElevation(i));
-                encoder.process(&factor, m_matrix + i * Decoder<Hoa3d, T>::getNumberOfHarmonics());
-                for(size_t j = 0; j < Decoder<Hoa3d, T>::getNumberOfHarmonics(); j++)
+                encoder.process(&factor, row);
+                for(size_t j = 0; j < nharmonics; j++)
                 {
-                    const size_t l = Decoder<Hoa3d, T>::getHarmonicDegree(j);
-                    if(encoder.getHarmonicOrder(j) == 0)
-                    {
-                        m_matrix[i * encoder.getNumberOfHarmonics() + j] *= (2. * l + 1.);
-                    }
-                    else
-                    {
-                        m_matrix[i * encoder.getNumberOfHarmonics() + j] *= T(2. * l + 1.) * 4. * HOA_PI;
-                    }
+                    row[j] *= weights[j];
                 }
             }
+            Signal<T>::free(weights);
         }
     };
 
@@ -724,17 +828,18 @@ namespace hoa
     {
         size_t       m_vector_size;
         size_t       m_crop_size;
-        T*          m_input;
-        T*          m_result;
-        T*          m_left;
-        T*          m_right;
+        size_t       m_tail;
+        Buffer<T>    m_input;
+        Buffer<T>    m_result;
+        Buffer<T>    m_left;
+        Buffer<T>    m_right;
 
         void clear()
         {
-            m_input  = Signal<T>::free(m_input);
-            m_result = Signal<T>::free(m_result);
-            m_left   = Signal<T>::free(m_left);
-            m_right  = Signal<T>::free(m_right);
+            m_input.resize(0ul);
+            m_result.resize(0ul);
+            m_left.resize(0ul);
+            m_right.resize(0ul);
         }
 
     public:
@@ -745,10 +850,7 @@ namespace hoa
          */
         Binaural(const size_t order) : Decoder<Hoa3d, T>(order, 2),
         m_vector_size(0ul),
-        m_input(hoa_nullptr),
-        m_result(hoa_nullptr),
-        m_left(hoa_nullptr),
-        m_right(hoa_nullptr)
+        m_tail(0ul)
         {
             Decoder<Hoa3d, T>::setPlanewaveAzimuth(0, (T)(HOA_PI2*3.));
             Decoder<Hoa3d, T>::setPlanewaveAzimuth(1, (T)HOA_PI2);
@@ -761,14 +863,6 @@ namespace hoa
          */
         inline Mode getMode() const hoa_noexcept hoa_override {return BinauralMode;};
 
-        //! The binaural decoder destructor.
-        /**	The binaural decoder destructor free the memory.
-         */
-        ~Binaural()
-        {
-            clear();
-        }
-
         //! This method sets the crop size of the responses.
         /**	This method sets the crop size of the responses.
          @param size The crop size.
@@ -809,10 +903,11 @@ namespace hoa
         {
             clear();
             m_vector_size  = vectorsize;
-            m_input  = Signal<T>::alloc(Hrir<Hoa3d, T>::getNumberOfColumns() * m_vector_size);
-            m_result = Signal<T>::alloc(Hrir<Hoa3d, T>::getNumberOfRows() * m_vector_size);
-            m_left   = Signal<T>::alloc(Hrir<Hoa3d, T>::getNumberOfRows() + m_vector_size);
-            m_right  = Signal<T>::alloc(Hrir<Hoa3d, T>::getNumberOfRows() + m_vector_size);
+            m_tail         = 0ul;
+            m_input.resize(Hrir<Hoa3d, T>::getNumberOfColumns() * m_vector_size);
+            m_result.resize(Hrir<Hoa3d, T>::getNumberOfRows() * m_vector_size);
+            m_left.resize(Hrir<Hoa3d, T>::getNumberOfRows() + m_vector_size);
+            m_right.resize(Hrir<Hoa3d, T>::getNumberOfRows() + m_vector_size);
         }
 
     private:
@@ -826,16 +921,46 @@ namespace hoa
             {
                 Signal<T>::add(m, m_result + i, n, vector + i, 1ul);
             }
+            processTail(vector, output);
+        }
 
+        inline void processTail(T* vector, T* output) hoa_noexcept
+        {
             Signal<T>::copy(m_vector_size, vector, output);
-            Signal<T>::copy(m, vector + m_vector_size, vector);
-            Signal<T>::clear(m_vector_size, vector + m);
+            Signal<T>::move(m_crop_size, vector + m_vector_size, vector);
+            Signal<T>::clear(m_vector_size, vector + m_crop_size);
         }
     public:
 
         //! This method performs the binaural decoding and the convolution.
+        /**	You should use this method for not-in-place processing of a block of samples. The inputs array contains the harmonics vectors and the outputs array contains the headphones vectors. When the inputs are silent, the convolution is skipped and only the remaining tail of the previous responses is written to the outputs until it has decayed.
+         @param     inputs	The input vectors.
+         @param     outputs  The output vectors.
+         */
         inline void processBlock(const T** inputs, T** outputs) hoa_noexcept
         {
+            bool silent = true;
+            for(size_t i = 0; i < Hrir<Hoa3d, T>::getNumberOfColumns() && i < Decoder<Hoa3d, T>::getNumberOfHarmonics() && silent; i++)
+            {
+                silent = Signal<T>::isZero(m_vector_size, inputs[i]);
+            }
+            if(silent)
+            {
+                if(m_tail)
+                {
+                    processTail(m_left, outputs[0]);
+                    processTail(m_right, outputs[1]);
+                    m_tail = (m_tail > m_vector_size) ? m_tail - m_vector_size : 0ul;
+                }
+                else
+                {
+                    Signal<T>::clear(m_vector_size, outputs[0]);
+                    Signal<T>::clear(m_vector_size, outputs[1]);
+                }
+                return;
+            }
+            m_tail = m_crop_size;
+
             T* input = m_input;
             for(size_t i = 0; i < Hrir<Hoa3d, T>::getNumberOfColumns() && i < Decoder<Hoa3d, T>::getNumberOfHarmonics(); i++)
             {
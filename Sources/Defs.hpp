@@ -81,7 +81,8 @@ namespace hoa
         sprintf(buffer, "%lf", val);
         return buffer;
     }
-
+#else
+    using std::to_string;
 #endif
 
     //! The dimension of class.
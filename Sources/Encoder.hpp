@@ -294,6 +294,37 @@ namespace hoa
              */
             virtual bool getMute(const size_t index) const hoa_noexcept;
 
+            //! Set the orientation of the scene (2d only).
+            /**	This method rotates all the signals of the scene around the z axis. The rotation is folded into the positions of the signals when they are set, so it costs nothing per sample contrary to a rotation of the harmonics. The azimuths of the signals are not modified.
+             @param yaw     The yaw.
+             */
+            virtual void setOrientation(const T yaw) hoa_noexcept;
+
+            //! Set the orientation of the scene (3d only).
+            /**	This method rotates all the signals of the scene by the roll around the x axis, then by the pitch around the y axis and then by the yaw around the z axis like the 3d rotate. The rotation is folded into the positions of the signals when they are set, so it costs nothing per sample contrary to a rotation of the harmonics. The azimuths and the elevations of the signals are not modified.
+             @param yaw     The yaw.
+             @param pitch   The pitch.
+             @param roll    The roll.
+             */
+            virtual void setOrientation(const T yaw, const T pitch, const T roll) hoa_noexcept;
+
+            //! Get the yaw of the scene.
+            /**	This method gets the yaw of the scene between 0 and 2π.
+             @return    The yaw.
+             */
+            virtual T getYaw() const hoa_noexcept;
+
+            //! Get the pitch of the scene (3d only).
+            /**	This method gets the pitch of the scene between -π and π.
+             @return    The pitch.
+             */
+            virtual T getPitch() const hoa_noexcept;
+
+            //! Get the roll of the scene (3d only).
+            /**	This method gets the roll of the scene between -π and π.
+             @return    The roll.
+             */
+            virtual T getRoll() const hoa_noexcept;
 
             //! This method performs the encoding with distance compensation.
             /**	You should use this method for in-place or not-in-place processing and sample by sample. The input array contains the samples of the sources and the minimum size should be the number of sources. The outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
@@ -370,14 +401,6 @@ namespace hoa
             setAzimuth(0.);
         }
 
-        //! The encoder destructor.
-        /**	The encoder destructor free the memory.
-         */
-        ~Basic() hoa_noexcept
-        {
-            ;
-        }
-
         //! This method set the azimuth.
         /**	The azimuth in radian and you should prefer to use it between 0 and 2π to avoid recursive wrapping of the value. The direction of rotation is counterclockwise. The 0 radian is π/2 phase shifted relative to a mathematical representation of a circle, then the 0 radian is at the "front" of the soundfield.
             @param     azimuth	The azimuth.
@@ -505,14 +528,6 @@ namespace hoa
             setMute(false);
         }
 
-        //! The encoder destructor.
-        /**	The encoder destructor free the memory.
-         */
-        ~DC() hoa_noexcept
-        {
-            ;
-        }
-
         //! This method set the azimuth.
         /**	The azimuth in radian and you should prefer to use it between 0 and 2π to avoid recursive wrapping of the value. The direction of rotation is counterclockwise. The 0 radian is π/2 phase shifted relative to a mathematical representation of a circle, then the 0 radian is at the "front" of the soundfield.
          @param     azimuth	The azimuth.
@@ -540,7 +555,7 @@ namespace hoa
          */
         inline void setRadius(const T radius) hoa_noexcept
         {
-            m_radius = max(radius, (T)0.);
+            m_radius = std::max(radius, (T)0.);
             if(m_radius < 1.)
             {
                 m_factor    = T((1. - m_radius) * HOA_PI);
@@ -664,8 +679,10 @@ namespace hoa
     template <typename T> class Encoder<Hoa2d, T>::Multi : public Encoder<Hoa2d, T>
     {
     private:
-        const size_t                     m_number_of_sources;
-        std::vector<Encoder<Hoa2d, T>::DC*>  m_encoders;
+        size_t                                  m_number_of_sources;
+        std::vector<typename Encoder<Hoa2d, T>::DC> m_encoders;
+        std::vector<T>                          m_azimuths;
+        T                                       m_yaw;
     public:
 
         //! The map constructor.
@@ -675,24 +692,12 @@ namespace hoa
          @param     numberOfSources	The number of sources.
          */
         Multi(const size_t order, size_t numberOfSources) hoa_noexcept : Encoder<Hoa2d, T>(order),
-        m_number_of_sources(numberOfSources)
-        {
-            for(size_t i = 0; i < m_number_of_sources; i++)
-            {
-                m_encoders.push_back(new Encoder<Hoa2d, T>::DC(order));
-            }
-        }
-
-        //! The map destructor.
-        /**	The map destructor free the memory and deallocate the member classes.
-         */
-        ~Multi() hoa_noexcept
+        m_number_of_sources(numberOfSources),
+        m_encoders(numberOfSources, typename Encoder<Hoa2d, T>::DC(order)),
+        m_azimuths(numberOfSources, T(0.)),
+        m_yaw(0.)
         {
-            for(size_t i = 0; i < m_number_of_sources; i++)
-            {
-                delete m_encoders[i];
-            }
-            m_encoders.clear();
+            ;
         }
 
         //! This method retrieve the number of sources.
@@ -714,7 +719,8 @@ namespace hoa
          */
         inline void setAzimuth(const size_t index, const T azimuth) hoa_noexcept
         {
-            m_encoders[index]->setAzimuth(azimuth);
+            m_azimuths[index] = azimuth;
+            m_encoders[index].setAzimuth(azimuth + m_yaw);
         }
 
         //! This method set the radius of a source.
@@ -726,7 +732,7 @@ namespace hoa
          */
         inline void setRadius(const size_t index, const T radius) hoa_noexcept
         {
-            m_encoders[index]->setRadius(radius);
+            m_encoders[index].setRadius(radius);
         }
 
         //! This method mute or unmute a source.
@@ -737,7 +743,7 @@ namespace hoa
          */
         inline void setMute(const size_t index, const bool muted) hoa_noexcept
         {
-            m_encoders[index]->setMute(muted);
+            m_encoders[index].setMute(muted);
         }
 
         //! This method retrieve the azimuth of a source.
@@ -748,7 +754,7 @@ namespace hoa
          */
         inline T getAzimuth(const size_t index) const hoa_noexcept
         {
-            return m_encoders[index]->getAzimuth();
+            return Math<T>::wrap_twopi(m_azimuths[index]);
         }
 
         //! This method retrieve the radius of a source.
@@ -759,7 +765,7 @@ namespace hoa
          */
         inline T getRadius(const size_t index) const hoa_noexcept
         {
-            return m_encoders[index]->getRadius();
+            return m_encoders[index].getRadius();
         }
 
         //! This method retrieve the mute or unmute state of a source.
@@ -771,9 +777,32 @@ namespace hoa
          */
         inline bool getMute(const size_t index) const hoa_noexcept
         {
-            return m_encoders[index]->getMute();
+            return m_encoders[index].getMute();
         }
 
+        //! This method set the orientation of the scene.
+        /**	The yaw rotates all the sources around the center of the circle, the direction of rotation is counterclockwise. The rotation is added to the azimuths of the sources so it costs nothing per sample, the azimuths returned by getAzimuth() are not modified.
+
+         @param     yaw	The yaw.
+         */
+        inline void setOrientation(const T yaw) hoa_noexcept
+        {
+            m_yaw = yaw;
+            for(size_t i = 0; i < m_number_of_sources; i++)
+            {
+                m_encoders[i].setAzimuth(m_azimuths[i] + m_yaw);
+            }
+        }
+
+        //! This method retrieve the yaw of the scene.
+        /** Retrieve the yaw of the scene between 0 and 2π.
+
+         @return The yaw.
+         */
+        inline T getYaw() const hoa_noexcept
+        {
+            return Math<T>::wrap_twopi(m_yaw);
+        }
 
         //! This method performs the encoding with distance compensation.
         /**	You should use this method for in-place or not-in-place processing and sample by sample. The input array contains the samples of the sources and the minimum size should be the number of sources. The outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
@@ -782,10 +811,10 @@ namespace hoa
          */
         inline void process(const T* input, T* outputs) hoa_noexcept hoa_override
         {
-            m_encoders[0]->process(input, outputs);
+            m_encoders[0].process(input, outputs);
             for(size_t i = 1; i < m_number_of_sources; i++)
             {
-                m_encoders[i]->processAdd(++input, outputs);
+                m_encoders[i].processAdd(++input, outputs);
             }
         }
     };
@@ -843,7 +872,7 @@ namespace hoa
         T  m_sin_phi;
         T  m_cos_theta;
         T  m_sqrt_rmin;
-        T* m_normalization;
+        const T* m_normalization;
         bool m_muted;
     public:
 
@@ -853,24 +882,12 @@ namespace hoa
          */
         Basic(const size_t order) hoa_noexcept : Encoder<Hoa3d, T>(order)
         {
-            m_normalization = Signal<T>::alloc(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics());
-            for(size_t i = 0; i < Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics(); i++)
-            {
-                m_normalization[i] = Processor<Hoa3d, T>::Harmonics::getHarmonicSemiNormalization(i);
-            }
+            m_normalization = Processor<Hoa3d, T>::Harmonics::getHarmonicTable().getSemiNormalizations();
             setMute(false);
             setAzimuth(0.);
             setElevation(0.);
         }
 
-        //! The encoder destructor.
-        /**	The encoder destructor free the memory.
-         */
-        ~Basic() hoa_noexcept
-        {
-            Signal<T>::free(m_normalization);
-        }
-
         //! This method mute or unmute.
         /**	Mute or unmute.
          @param     muted	The mute state.
@@ -1144,8 +1161,8 @@ namespace hoa
         T  m_cos_theta;
         T  m_sqrt_rmin;
         T  m_radius;
-        T* m_normalization;
-        T* m_distance;
+        const T* m_normalization;
+        Buffer<T> m_distance;
         bool m_muted;
     public:
 
@@ -1155,28 +1172,14 @@ namespace hoa
          */
         DC(const size_t order) hoa_noexcept : Encoder<Hoa3d, T>(order)
         {
-            m_normalization = Signal<T>::alloc(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics());
-            for(size_t i = 0; i < Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics(); i++)
-            {
-                m_normalization[i] = Processor<Hoa3d, T>::Harmonics::getHarmonicSemiNormalization(i);
-            }
-            m_distance = Signal<T>::alloc(Processor<Hoa3d, T>::Harmonics::getDecompositionOrder());
+            m_normalization = Processor<Hoa3d, T>::Harmonics::getHarmonicTable().getSemiNormalizations();
+            m_distance.resize(Processor<Hoa3d, T>::Harmonics::getDecompositionOrder() + 1);
             setMute(false);
             setAzimuth(0.);
             setElevation(0.);
             setRadius(1.);
         }
 
-        //! The encoder destructor.
-        /**	The encoder destructor free the memory.
-         */
-        ~DC() hoa_noexcept
-        {
-            Signal<T>::free(m_normalization);
-            Signal<T>::free(m_distance);
-
-        }
-
         //! This method set the azimuth.
         /**	The azimuth in radian and you should prefer to use it between 0 and 2π to avoid recursive wrapping of the value. The direction of rotation is counterclockwise. The 0 radian is π/2 phase shifted relative to a mathematical representation of a circle, then the 0 radian is at the "front" of the soundfield.
          @param     azimuth	The azimuth.
@@ -1225,7 +1228,7 @@ namespace hoa
          */
         inline void setRadius(const T radius) hoa_noexcept
         {
-            m_radius = max(radius, (T)0.);
+            m_radius = std::max(radius, (T)0.);
             T factor, gain, dist;
             if(m_radius < 1.)
             {
@@ -1466,8 +1469,35 @@ namespace hoa
     template <typename T> class Encoder<Hoa3d, T>::Multi : public Encoder<Hoa3d, T>
     {
     private:
-        const size_t                     m_number_of_sources;
-        std::vector<Encoder<Hoa3d, T>::DC *> m_encoders;
+        size_t                                  m_number_of_sources;
+        std::vector<typename Encoder<Hoa3d, T>::DC> m_encoders;
+        std::vector<T>                          m_azimuths;
+        std::vector<T>                          m_elevations;
+        T                                       m_yaw;
+        T                                       m_pitch;
+        T                                       m_roll;
+        T                                       m_rotation[9];
+        bool                                    m_rotated;
+
+        inline void computePosition(const size_t index) hoa_noexcept
+        {
+            if(!m_rotated)
+            {
+                m_encoders[index].setAzimuth(m_azimuths[index]);
+                m_encoders[index].setElevation(m_elevations[index]);
+                return;
+            }
+            const T cos_el = std::cos(m_elevations[index]);
+            const T x = std::cos(m_azimuths[index]) * cos_el;
+            const T y = std::sin(m_azimuths[index]) * cos_el;
+            const T z = std::sin(m_elevations[index]);
+            const T* r = m_rotation;
+            const T rx = r[0] * x + r[1] * y + r[2] * z;
+            const T ry = r[3] * x + r[4] * y + r[5] * z;
+            const T rz = r[6] * x + r[7] * y + r[8] * z;
+            m_encoders[index].setAzimuth(std::atan2(ry, rx));
+            m_encoders[index].setElevation(std::asin(Math<T>::clip(rz, T(-1.), T(1.))));
+        }
     public:
 
         //! The map constructor.
@@ -1477,24 +1507,16 @@ namespace hoa
          @param     numberOfSources	The number of sources.
          */
         Multi(const size_t order, size_t numberOfSources) hoa_noexcept : Encoder<Hoa3d, T>(order),
-        m_number_of_sources(numberOfSources)
-        {
-            for(size_t i = 0; i < m_number_of_sources; i++)
-            {
-                m_encoders.push_back(new Encoder<Hoa3d, T>::DC(order));
-            }
-        }
-
-        //! The map destructor.
-        /**	The map destructor free the memory and deallocate the member classes.
-         */
-        ~Multi() hoa_noexcept
+        m_number_of_sources(numberOfSources),
+        m_encoders(numberOfSources, typename Encoder<Hoa3d, T>::DC(order)),
+        m_azimuths(numberOfSources, T(0.)),
+        m_elevations(numberOfSources, T(0.)),
+        m_yaw(0.),
+        m_pitch(0.),
+        m_roll(0.),
+        m_rotated(false)
         {
-            for(size_t i = 0; i < m_number_of_sources; i++)
-            {
-                delete m_encoders[i];
-            }
-            m_encoders.clear();
+            ;
         }
 
         //! This method retrieve the number of sources.
@@ -1516,7 +1538,8 @@ namespace hoa
          */
         inline void setAzimuth(const size_t index, const T azimuth) hoa_noexcept
         {
-            m_encoders[index]->setAzimuth(azimuth);
+            m_azimuths[index] = azimuth;
+            computePosition(index);
         }
 
         //! This method set the angle of azimuth of a source.
@@ -1528,7 +1551,8 @@ namespace hoa
          */
         inline void setElevation(const size_t index, const T elevation) hoa_noexcept
         {
-            m_encoders[index]->setElevation(elevation);
+            m_elevations[index] = elevation;
+            computePosition(index);
         }
 
         //! This method set the radius of a source.
@@ -1540,7 +1564,7 @@ namespace hoa
          */
         inline void setRadius(const size_t index, const T radius) hoa_noexcept
         {
-            m_encoders[index]->setRadius(radius);
+            m_encoders[index].setRadius(radius);
         }
 
         //! This method mute or unmute a source.
@@ -1551,7 +1575,7 @@ namespace hoa
          */
         inline void setMute(const size_t index, const bool muted) hoa_noexcept
         {
-            m_encoders[index]->setMute(muted);
+            m_encoders[index].setMute(muted);
         }
 
         //! This method retrieve the azimuth of a source.
@@ -1562,7 +1586,7 @@ namespace hoa
          */
         inline T getAzimuth(const size_t index) const hoa_noexcept
         {
-            return m_encoders[index]->getAzimuth();
+            return Math<T>::wrap_twopi(m_azimuths[index]);
         }
 
         //! This method retrieve the elevation of a source.
@@ -1573,7 +1597,7 @@ namespace hoa
          */
         inline T getElevation(const size_t index) const hoa_noexcept
         {
-            return m_encoders[index]->getElevation();
+            return Math<T>::wrap_pi(m_elevations[index]);
         }
 
         //! This method retrieve the radius of a source.
@@ -1584,7 +1608,7 @@ namespace hoa
          */
         inline T getRadius(const size_t index) const hoa_noexcept
         {
-            return m_encoders[index]->getRadius();
+            return m_encoders[index].getRadius();
         }
 
         //! This method retrieve the mute or unmute state of a source.
@@ -1596,9 +1620,64 @@ namespace hoa
          */
         inline bool getMute(const size_t index) const hoa_noexcept
         {
-            return m_encoders[index]->getMute();
+            return m_encoders[index].getMute();
         }
 
+        //! This method set the orientation of the scene.
+        /**	The orientation rotates all the sources around the center of the sphere, the scene is rotated by the roll around the x axis, then by the pitch around the y axis and then by the yaw around the z axis like the 3d rotate. The rotation is applied to the directions of the sources so it costs nothing per sample, the azimuths and the elevations returned by getAzimuth() and getElevation() are not modified.
+
+         @param     yaw     The yaw.
+         @param     pitch   The pitch, a positive value moves the front toward the top.
+         @param     roll    The roll, a positive value moves the left toward the top.
+         */
+        inline void setOrientation(const T yaw, const T pitch, const T roll) hoa_noexcept
+        {
+            m_yaw   = yaw;
+            m_pitch = pitch;
+            m_roll  = roll;
+            m_rotated = (yaw != T(0.) || pitch != T(0.) || roll != T(0.));
+
+            const T cy = std::cos(m_yaw),   sy = std::sin(m_yaw);
+            const T cp = std::cos(m_pitch), sp = std::sin(m_pitch);
+            const T cr = std::cos(m_roll),  sr = std::sin(m_roll);
+            m_rotation[0] = cy * cp; m_rotation[1] = -cy * sp * sr - sy * cr; m_rotation[2] = -cy * sp * cr + sy * sr;
+            m_rotation[3] = sy * cp; m_rotation[4] = -sy * sp * sr + cy * cr; m_rotation[5] = -sy * sp * cr - cy * sr;
+            m_rotation[6] = sp;      m_rotation[7] = cp * sr;                 m_rotation[8] = cp * cr;
+            for(size_t i = 0; i < m_number_of_sources; i++)
+            {
+                computePosition(i);
+            }
+        }
+
+        //! This method retrieve the yaw of the scene.
+        /** Retrieve the yaw of the scene between 0 and 2π.
+
+         @return The yaw.
+         */
+        inline T getYaw() const hoa_noexcept
+        {
+            return Math<T>::wrap_twopi(m_yaw);
+        }
+
+        //! This method retrieve the pitch of the scene.
+        /** Retrieve the pitch of the scene between -π and π.
+
+         @return The pitch.
+         */
+        inline T getPitch() const hoa_noexcept
+        {
+            return Math<T>::wrap_pi(m_pitch);
+        }
+
+        //! This method retrieve the roll of the scene.
+        /** Retrieve the roll of the scene between -π and π.
+
+         @return The roll.
+         */
+        inline T getRoll() const hoa_noexcept
+        {
+            return Math<T>::wrap_pi(m_roll);
+        }
 
         //! This method performs the encoding with distance compensation.
         /**	You should use this method for in-place or not-in-place processing and sample by sample. The input array contains the samples of the sources and the minimum size should be the number of sources. The outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
@@ -1607,10 +1686,10 @@ namespace hoa
          */
         inline void process(const T* input, T* outputs) hoa_noexcept hoa_override
         {
-            m_encoders[0]->process(input, outputs);
+            m_encoders[0].process(input, outputs);
             for(size_t i = 1; i < m_number_of_sources; i++)
             {
-                m_encoders[i]->processAdd(++input, outputs);
+                m_encoders[i].processAdd(++input, outputs);
             }
         }
     };
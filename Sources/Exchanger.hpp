@@ -12,7 +12,7 @@
 namespace hoa
 {
     //! The echanger class renumber and normalize the harmonics channels.
-    /** The echanger should be used to renumber and normalize the harmonics channels. The library uses the Ambisonics Channels Numbering (ACN), this class allows to convert channels arrengements from Furse-Malham (B-format) or Single Index (SID) to  Ambisonics Channels Numbering (ACN) and conversely. Furse-Malham and SID never reach up to 3rd order so the maximum order of decomposition should be 3. The library uses the semi-normalization (SN2D and SN3D), this class allows to normalize the channels to the full normalization (N2D and N3D) or to MaxN (B-format) and conversely.
+    /** The echanger should be used to renumber and normalize the harmonics channels. The library uses the Ambisonics Channels Numbering (ACN), this class allows to convert channels arrengements from Furse-Malham (B-format) or Single Index (SID) to  Ambisonics Channels Numbering (ACN) and conversely. The conversion is computed as a table that maps each output channel to an input channel with a gain, so any order is supported. Furse-Malham and MaxN are only defined up to the 3rd order, the higher channels keep the ACN numbering and the semi-normalization. The library uses the semi-normalization (SN2D and SN3D), this class allows to normalize the channels to the full normalization (N2D and N3D) or to MaxN (B-format) and conversely.
      */
     template <Dimension D, typename T> class Exchanger : public Processor<D, T>::Harmonics
     {
@@ -44,7 +44,7 @@ namespace hoa
         };
 
         //! The exchanger constructor.
-        /**	The exchanger constructor allocates and initialize the member values to renumber and normalize the harmonics channels. The order must be at least 1 and should be 3 at maximum.
+        /**	The exchanger constructor allocates and initialize the member values to renumber and normalize the harmonics channels. The order must be at least 1.
          @param     order	The order.
          */
         Exchanger(const size_t order) hoa_noexcept;
@@ -61,6 +61,14 @@ namespace hoa
          */
         virtual void process(T const* inputs, T* outputs) hoa_noexcept;
 
+        //! This method performs the numbering and the normalization of a block of samples.
+        /**	You should use this method for in-place or not-in-place processing of a block of samples. The inputs matrix and the outputs matrix contain the harmonics samples with one row per harmonic (harmonics × vector size).
+         @param     vectorsize  The vector size.
+         @param     inputs      The inputs matrix.
+         @param     outputs     The outputs matrix.
+         */
+        virtual void processBlock(const size_t vectorsize, T const* inputs, T* outputs) hoa_noexcept;
+
         //! Sets the numbering conversion.
         /**	This method sets the numbering conversion.
          @param mode The numbering convertion.
@@ -144,25 +152,59 @@ namespace hoa
     private:
         Numbering       m_numbering;
         Normalization   m_normalization;
-    public:
+        std::vector<size_t>                     m_permutation;
+        std::vector< std::pair<size_t, size_t> > m_swaps;
+        Buffer<T>                               m_gains;
 
-        //! The exchanger constructor.
-        /**	The exchanger constructor allocates and initialize the member values to renumber and normalize the harmonics channels. The order must be at least 1 and should be 3 at maximum.
-         @param     order	The order.
-         */
-        inline Exchanger(const size_t order) hoa_noexcept : Processor<Hoa2d, T>::Harmonics(order),
-        m_numbering(ACN),
-        m_normalization(SN2D)
+        //! Computes the table of the conversion.
+        /** The output harmonic i is the input harmonic m_permutation[i] scaled by m_gains[i]. The Furse-Malham numbering is defined up to the third order, the higher harmonics keep the ACN numbering. */
+        void computeTable()
         {
-            ;
+            const size_t nharmonics = Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics();
+            const size_t nfursemalham = 7ul;
+            std::vector<size_t> acn(nharmonics);
+            for(size_t i = 0; i < nharmonics; i++)
+            {
+                const bool swapped = (m_numbering == fromSID || m_numbering == toSID) || ((m_numbering == fromFurseMalham || m_numbering == toFurseMalham) && i < nfursemalham);
+                acn[i] = (swapped && i) ? ((i % 2) ? i + 1 : i - 1) : i;
+            }
+            T w = T(1.);
+            if(m_normalization == fromMaxN)
+            {
+                w = T(sqrt(2.));
+            }
+            else if(m_normalization == toMaxN)
+            {
+                w = T(1. / sqrt(2.));
+            }
+            for(size_t i = 0; i < nharmonics; i++)
+            {
+                m_permutation[i] = acn[i];
+                m_gains[i] = acn[i] ? T(1.) : w;
+            }
+            m_swaps.clear();
+            std::vector<bool> visited(nharmonics, false);
+            for(size_t i = 0; i < nharmonics; i++)
+            {
+                size_t current = i;
+                visited[current] = true;
+                while(!visited[m_permutation[current]])
+                {
+                    m_swaps.push_back(std::pair<size_t, size_t>(current, m_permutation[current]));
+                    current = m_permutation[current];
+                    visited[current] = true;
+                }
+            }
         }
+    public:
 
-        //! The exchanger destructor.
-        /**	The exchanger destructor free the memory.
-         */
-        inline ~Exchanger() hoa_noexcept
+        inline Exchanger(const size_t order) hoa_noexcept : Processor<Hoa2d, T>::Harmonics(order),
+        m_numbering(ACN),
+        m_normalization(SN2D),
+        m_permutation(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics()),
+        m_gains(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics())
         {
-            ;
+            computeTable();
         }
 
         //! Sets the numbering and the normalization conversion from B-Format.
@@ -172,6 +214,7 @@ namespace hoa
         {
             m_numbering = fromFurseMalham;
             m_normalization = fromMaxN;
+            computeTable();
         }
 
         //! Sets the numbering and the normalization conversion to B-Format.
@@ -181,6 +224,7 @@ namespace hoa
         {
             m_numbering = toFurseMalham;
             m_normalization = toMaxN;
+            computeTable();
         }
 
         //! Sets the numbering conversion.
@@ -190,6 +234,7 @@ namespace hoa
         inline void setNumbering(const Numbering mode) hoa_noexcept
         {
             m_numbering = mode;
+            computeTable();
         }
 
         //! Gets the numbering conversion.
@@ -208,6 +253,7 @@ namespace hoa
         inline void setNormalization(const Normalization mode) hoa_noexcept
         {
             m_normalization = mode;
+            computeTable();
         }
 
         //! Gets the normalization conversion.
@@ -219,7 +265,6 @@ namespace hoa
             return m_normalization;
         }
 
-
         //! This method performs the numbering and the normalization.
         /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
          @param     inputs   The inputs array.
@@ -227,130 +272,57 @@ namespace hoa
          */
         void process(T const* inputs, T* outputs) hoa_noexcept
         {
-            T const* ins = inputs;
-            if(m_numbering == fromFurseMalham)
-            {
-                numberFromFurseMalham(inputs, outputs);
-                ins = outputs;
-            }
-            else if(m_numbering == fromSID)
-            {
-                numberFromSID(inputs, outputs);
-                ins = outputs;
-            }
-            switch(m_normalization)
-            {
-                case fromMaxN:
-                    outputs[0] = ins[0] * T(sqrt(2.));
-                    Signal<T>::copy(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics() - 1, ins+1, outputs+1);
-                    ins = outputs;
-                    break;
-                case toMaxN:
-                    outputs[0] = ins[0] / T(sqrt(2.));
-                    Signal<T>::copy(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics() - 1, ins+1, outputs+1);
-                    ins = outputs;
-                    break;
-                default:
-                    break;
-            }
-            if(m_numbering == toFurseMalham)
+            const size_t nharmonics = Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics();
+            if(inputs != outputs)
             {
-                numberToFurseMalham(ins, outputs);
-            }
-            else if(m_numbering == toSID)
-            {
-                numberToSID(ins, outputs);
+                for(size_t i = 0; i < nharmonics; i++)
+                {
+                    outputs[i] = inputs[m_permutation[i]] * m_gains[i];
+                }
             }
-        }
-
-        //! This method number the channels from Furse-Malham to ACN.
-        /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
-         @param     inputs   The inputs array.
-         @param     outputs  The outputs array.
-         */
-        void numberFromFurseMalham(T const* inputs, T* outputs) hoa_noexcept
-        {
-            T temp = inputs[1];
-            *(outputs++) = inputs[0]; // W -> 0
-            *(outputs++) = inputs[2]; // Y -> 1
-            *(outputs++) = temp;      // X -> 2
-            if(Processor<Hoa2d, T>::Harmonics::getDecompositionOrder() > 1ul)
+            else
             {
-                temp       = inputs[3];
-                *(outputs++) = inputs[4]; // V -> 3
-                *(outputs++) = temp;      // U -> 4
-                if(Processor<Hoa2d, T>::Harmonics::getDecompositionOrder() > 2ul)
+                for(size_t i = 0; i < m_swaps.size(); i++)
                 {
-                    temp       = inputs[5];
-                    *(outputs++) = inputs[6]; // Q -> 5
-                    *(outputs++) = temp;      // U -> 6
+                    std::swap(outputs[m_swaps[i].first], outputs[m_swaps[i].second]);
                 }
+                Signal<T>::mul(nharmonics, outputs, m_gains, outputs);
             }
         }
 
-        //! This method number the channels from SID to ACN.
-        /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
-         @param     inputs   The inputs array.
-         @param     outputs  The outputs array.
+        //! This method performs the numbering and the normalization of a block of samples.
+        /**	You should use this method for in-place or not-in-place processing of a block of samples. The inputs matrix and the outputs matrix contain the harmonics samples with one row per harmonic (harmonics × vector size). The rows are gathered and scaled in one pass, or swapped along the cycles of the permutation and then scaled for in-place processing.
+         @param     vectorsize  The vector size.
+         @param     inputs      The inputs matrix.
+         @param     outputs     The outputs matrix.
          */
-        void numberFromSID(T const* inputs, T* outputs) hoa_noexcept
+        void processBlock(const size_t vectorsize, T const* inputs, T* outputs) hoa_noexcept
         {
-            T temp = inputs[1];
-            *(outputs++) = inputs[0]; // 0 -> 0
-            *(outputs++) = inputs[2]; // 2 -> 1
-            *(outputs++) = temp;      // 1 -> 2
-            for(size_t i = 2; i <= Processor<Hoa2d, T>::Harmonics::getDecompositionOrder(); i++)
+            const size_t nharmonics = Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics();
+            if(inputs != outputs)
             {
-                temp         = inputs[(i-1)*2+1];
-                *(outputs++) = inputs[(i-1)*2+2];
-                *(outputs++) = temp;
+                for(size_t i = 0; i < nharmonics; i++)
+                {
+                    Signal<T>::scale(vectorsize, m_gains[i], inputs + m_permutation[i] * vectorsize, outputs + i * vectorsize);
+                }
             }
-        }
-
-        //! This method number the channels from ACN to Furse-Malham.
-        /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
-         @param     inputs   The inputs array.
-         @param     outputs  The outputs array.
-         */
-        void numberToFurseMalham(T const* inputs, T* outputs) hoa_noexcept
-        {
-            T temp = inputs[1];
-            *(outputs++) = inputs[0]; // 0 -> W
-            *(outputs++) = inputs[2]; // 2 -> X
-            *(outputs++) = temp;      // 1 -> Y
-            if(Processor<Hoa2d, T>::Harmonics::getDecompositionOrder() > 1ul)
+            else
             {
-                temp       = inputs[3];
-                *(outputs++) = inputs[4]; // 4 -> U
-                *(outputs++) = temp;      // 3 -> V
-                if(Processor<Hoa2d, T>::Harmonics::getDecompositionOrder() > 2ul)
+                for(size_t i = 0; i < m_swaps.size(); i++)
                 {
-                    temp       = inputs[5];
-                    *(outputs++) = inputs[6]; // 6 -> U
-                    *(outputs++) = temp;      // 5 -> Q
+                    T* first = outputs + m_swaps[i].first * vectorsize;
+                    std::swap_ranges(first, first + vectorsize, outputs + m_swaps[i].second * vectorsize);
+                }
+                for(size_t i = 0; i < nharmonics; i++)
+                {
+                    if(m_gains[i] != T(1.))
+                    {
+                        Signal<T>::scale(vectorsize, m_gains[i], outputs + i * vectorsize);
+                    }
                 }
             }
         }
 
-        //! This method number the channels from ACN to SID.
-        /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
-         @param     inputs   The inputs array.
-         @param     outputs  The outputs array.
-         */
-        void numberToSID(T const* inputs, T* outputs) hoa_noexcept
-        {
-            T temp = inputs[1];
-            *(outputs++) = inputs[0]; // 0 -> 0
-            *(outputs++) = inputs[2]; // 2 -> 1
-            *(outputs++) = temp;      // 1 -> 2
-            for(size_t i = 2; i <= Processor<Hoa2d, T>::Harmonics::getDecompositionOrder(); i++)
-            {
-                temp         = inputs[(i-1)*2+1];
-                *(outputs++) = inputs[(i-1)*2+2];
-                *(outputs++) = temp;
-            }
-        }
-        
         //! Retrieve the harmonic order of an input depending on the current numbering configuration.
         /** Retrieve the harmonic order of an input depending on the current numbering configuration.
          @param     index	The index of an harmonic.
@@ -458,26 +430,102 @@ namespace hoa
 
         Numbering       m_numbering;
         Normalization   m_normalization;
-        T*              m_harmonics;
+        std::vector<size_t>                     m_permutation;
+        std::vector< std::pair<size_t, size_t> > m_swaps;
+        Buffer<T>                               m_gains;
+
+        //! Computes the table of the conversion.
+        /** The output harmonic i is the input harmonic m_permutation[i] scaled by m_gains[i]. The Furse-Malham numbering and the MaxN normalization are defined up to the third order, the higher harmonics keep the ACN numbering and the semi-normalization. */
+        void computeTable()
+        {
+            const size_t nharmonics = Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics();
+            const size_t nfursemalham = 16ul;
+            static const size_t fursemalham[16] = {0, 2, 3, 1, 8, 6, 4, 5, 7, 15, 13, 11, 9, 10, 12, 14};
+            const double maxn[16] = {sqrt(2.), sqrt(3.), sqrt(3.), sqrt(3.),
+                sqrt(15.) / 2., sqrt(15.) / 2., sqrt(5.), sqrt(15.) / 2., sqrt(15.) / 2.,
+                sqrt(35. / 8.), sqrt(35.) / 3., sqrt(224. / 45), sqrt(7.), sqrt(224. / 45), sqrt(35.) / 3., sqrt(35. / 8.)};
+
+            // The input index of each ACN harmonic for the conversions to ACN.
+            std::vector<size_t> acn(nharmonics);
+            for(size_t i = 0; i < nharmonics; i++)
+            {
+                const size_t degree = Processor<Hoa3d, T>::Harmonics::getHarmonicDegree(i);
+                const size_t offset = degree * degree;
+                const size_t j = i - offset;
+                if((m_numbering == fromFurseMalham || m_numbering == toFurseMalham) && i < nfursemalham)
+                {
+                    acn[i] = fursemalham[i];
+                }
+                else if(m_numbering == fromSID || m_numbering == toSID)
+                {
+                    acn[i] = offset + ((j % 2) ? (j / 2) : (2 * degree - j / 2));
+                }
+                else
+                {
+                    acn[i] = i;
+                }
+            }
+
+            // The gain of each harmonic in ACN, the MaxN table contains the ratios between N3D and MaxN.
+            std::vector<double> gains(nharmonics, 1.);
+            for(size_t i = 0; i < nharmonics; i++)
+            {
+                const double n3d = sqrt(2. * double(Processor<Hoa3d, T>::Harmonics::getHarmonicDegree(i)) + 1.);
+                if(m_normalization == fromN3D)
+                {
+                    gains[i] = n3d;
+                }
+                else if(m_normalization == toN3D)
+                {
+                    gains[i] = 1. / n3d;
+                }
+                else if(m_normalization == fromMaxN && i < nfursemalham)
+                {
+                    gains[i] = maxn[i] / n3d;
+                }
+                else if(m_normalization == toMaxN && i < nfursemalham)
+                {
+                    gains[i] = n3d / maxn[i];
+                }
+            }
+
+            const bool toacn = (m_numbering == ACN || m_numbering == fromFurseMalham || m_numbering == fromSID);
+            for(size_t i = 0; i < nharmonics; i++)
+            {
+                if(toacn)
+                {
+                    m_permutation[i] = acn[i];
+                    m_gains[i] = T(gains[i]);
+                }
+                else
+                {
+                    m_permutation[acn[i]] = i;
+                    m_gains[acn[i]] = T(gains[i]);
+                }
+            }
+            m_swaps.clear();
+            std::vector<bool> visited(nharmonics, false);
+            for(size_t i = 0; i < nharmonics; i++)
+            {
+                size_t current = i;
+                visited[current] = true;
+                while(!visited[m_permutation[current]])
+                {
+                    m_swaps.push_back(std::pair<size_t, size_t>(current, m_permutation[current]));
+                    current = m_permutation[current];
+                    visited[current] = true;
+                }
+            }
+        }
     public:
 
-        //! The exchanger constructor.
-        /**	The exchanger constructor allocates and initialize the member values to renumber and normalize the harmonics channels. The order must be at least 1 and should be 3 at maximum.
-         @param     order	The order.
-         */
         inline Exchanger(const size_t order) hoa_noexcept : Processor<Hoa3d, T>::Harmonics(order),
         m_numbering(ACN),
-        m_normalization(SN3D)
+        m_normalization(SN3D),
+        m_permutation(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics()),
+        m_gains(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics())
         {
-            m_harmonics = Signal<T>::alloc(order*2+1);
-        }
-
-        //! The exchanger destructor.
-        /**	The exchanger destructor free the memory.
-         */
-        inline ~Exchanger() hoa_noexcept
-        {
-            Signal<T>::free(m_harmonics);
+            computeTable();
         }
 
         //! Sets the numbering and the normalization conversion from B-Format.
@@ -487,6 +535,7 @@ namespace hoa
         {
             m_numbering = fromFurseMalham;
             m_normalization = fromMaxN;
+            computeTable();
         }
 
         //! Sets the numbering and the normalization conversion to B-Format.
@@ -496,6 +545,7 @@ namespace hoa
         {
             m_numbering = toFurseMalham;
             m_normalization = toMaxN;
+            computeTable();
         }
 
         //! Sets the numbering and the normalization conversion from B-Format.
@@ -505,6 +555,7 @@ namespace hoa
         {
             m_numbering = fromSID;
             m_normalization = fromN3D;
+            computeTable();
         }
 
         //! Sets the numbering and the normalization conversion to B-Format.
@@ -514,6 +565,7 @@ namespace hoa
         {
             m_numbering = toSID;
             m_normalization = toN3D;
+            computeTable();
         }
 
         //! Sets the numbering conversion.
@@ -523,6 +575,7 @@ namespace hoa
         inline void setNumbering(const Numbering mode) hoa_noexcept
         {
             m_numbering = mode;
+            computeTable();
         }
 
         //! Gets the numbering conversion.
@@ -541,6 +594,7 @@ namespace hoa
         inline void setNormalization(const Normalization mode) hoa_noexcept
         {
             m_normalization = mode;
+            computeTable();
         }
 
         //! Gets the normalization conversion.
@@ -559,293 +613,57 @@ namespace hoa
          */
         void process(T const* inputs, T* outputs) hoa_noexcept
         {
-            T const* ins = inputs;
-            if(m_numbering == fromFurseMalham)
-            {
-                numberFromFurseMalham(inputs, outputs);
-                ins = outputs;
-            }
-            else if(m_numbering == fromSID)
-            {
-                numberFromSID(inputs, outputs);
-                ins = outputs;
-            }
-            switch(m_normalization)
-            {
-                case fromMaxN:
-                    normalizeFromMaxN(ins, outputs);
-                    ins = outputs;
-                    break;
-                case fromN3D:
-                    normalizeFromN3D(ins, outputs);
-                    ins = outputs;
-                    break;
-                case toMaxN:
-                    normalizeToMaxN(ins, outputs);
-                    ins = outputs;
-                    break;
-                case toN3D:
-                    normalizeToN3D(ins, outputs);
-                    ins = outputs;
-                    break;
-                default:
-                    break;
-            }
-            if(m_numbering == toFurseMalham)
-            {
-                numberToFurseMalham(ins, outputs);
-            }
-            else if(m_numbering == toSID)
-            {
-                numberToSID(ins, outputs);
-            }
-        }
-
-        //! This method number the channels from Furse-Malham to ACN.
-        /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
-         @param     inputs   The inputs array.
-         @param     outputs  The outputs array.
-         */
-        void numberFromFurseMalham(T const* inputs, T* outputs) hoa_noexcept
-        {
-            T temp = inputs[1];
-            outputs[0] = inputs[0]; // W(0) -> 0
-            outputs[1] = inputs[2]; // Y(2) -> 1
-            outputs[2] = inputs[3]; // Z(3) -> 2
-            outputs[3] = temp;      // X(1) -> 3
-            if(Processor<Hoa3d, T>::Harmonics::getDecompositionOrder() > 1ul)
+            const size_t nharmonics = Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics();
+            if(inputs != outputs)
             {
-                temp         = inputs[4];
-                T temp2      = inputs[5];
-                T temp3      = inputs[7];
-                outputs[4] = inputs[8]; // V(8) -> 4
-                outputs[5] = inputs[6]; // T(6) -> 5
-                outputs[6] = temp;      // R(4) -> 6
-                outputs[7] = temp2;     // S(5) -> 7
-                outputs[8] = temp3;     // U(7) -> 8
-                if(Processor<Hoa3d, T>::Harmonics::getDecompositionOrder() > 2ul)
+                for(size_t i = 0; i < nharmonics; i++)
                 {
-                    temp      = inputs[9];
-                    temp2     = inputs[10];
-                    temp3     = inputs[12];
-                    const T temp4   = inputs[14];
-                    outputs[9]  = inputs[15];// Q(15) -> 9
-                    outputs[10] = inputs[13];// O(13) -> 10
-                    outputs[11] = inputs[11];// M(11) -> 11
-                    outputs[12] = temp;      // K(9)  -> 12
-                    outputs[13] = temp2;     // L(10) -> 13
-                    outputs[14] = temp3;     // N(12) -> 14
-                    outputs[15] = temp4;     // P(14) -> 15
-                    if(Processor<Hoa3d, T>::Harmonics::getDecompositionOrder() > 3ul)
-                    {
-                        Signal<T>::copy(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics() - 16ul, inputs+16, outputs+16);
-                    }
+                    outputs[i] = inputs[m_permutation[i]] * m_gains[i];
                 }
             }
-        }
-
-        //! This method number the channels from ACN to Furse-Malham.
-        /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
-         @param     inputs   The inputs array.
-         @param     outputs  The outputs array.
-         */
-        void numberToFurseMalham(T const* inputs, T* outputs) hoa_noexcept
-        {
-            T temp  = inputs[1];
-            T temp2 = inputs[2];
-            outputs[0] = inputs[0]; // 0 -> W(0)
-            outputs[1] = inputs[3]; // 3 -> X(1)
-            outputs[2] = temp;      // 1 -> Y(2)
-            outputs[3] = temp2;     // 2 -> Z(3)
-            if(Processor<Hoa3d, T>::Harmonics::getDecompositionOrder() > 1ul)
-            {
-                temp       = inputs[4];
-                temp2      = inputs[5];
-                outputs[4] = inputs[6]; // 6 -> R(4)
-                outputs[5] = inputs[7]; // 7 -> S(5)
-                outputs[6] = temp2;     // 5 -> T(6)
-                outputs[7] = inputs[8]; // 8 -> U(7)
-                outputs[8] = temp;      // 4 -> V(8)
-                if(Processor<Hoa3d, T>::Harmonics::getDecompositionOrder() > 2ul)
-                {
-                    temp            = inputs[9];
-                    temp2           = inputs[10];
-                    outputs[9]  = inputs[12];// 12 -> K(9)
-                    outputs[10] = inputs[13];// 13 -> L(10)
-                    outputs[11] = inputs[11];// 11 -> M(11)
-                    outputs[12] = inputs[14];// 14 -> N(12)
-                    outputs[13] = temp2;     // 10 -> 0(13)
-                    outputs[14] = inputs[15];// 15 -> P(14)
-                    outputs[15] = temp;      // 9  -> Q(15)
-                    if(Processor<Hoa3d, T>::Harmonics::getDecompositionOrder() > 3ul)
-                    {
-                        Signal<T>::copy(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics() - 16ul, inputs+16, outputs+16);
-                    }
-                }
-            }
-        }
-
-        //! This method number the channels from SID to ACN.
-        /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
-         @param     inputs   The inputs array.
-         @param     outputs  The outputs array.
-         */
-        void numberFromSID(T const* inputs, T* outputs) hoa_noexcept
-        {
-            *(outputs++) = *(inputs++);
-            for(size_t i = 1ul; i <= Processor<Hoa3d, T>::Harmonics::getDecompositionOrder(); i++)
-            {
-                for(size_t j = 0; j < 2ul * i + 1ul; j++)
-                {
-                    if(j%2)
-                    {
-                        m_harmonics[j] = inputs[size_t(j/2)];
-                    }
-                    else
-                    {
-                        m_harmonics[j] = inputs[2ul * i - size_t(j/2)];
-                    }
-                }
-                Signal<T>::copy(i * 2ul + 1ul, m_harmonics, outputs);
-                outputs += i * 2ul + 1ul;
-                inputs += i * 2ul + 1ul;
-            }
-        }
-
-        //! This method number the channels from ACN to SID.
-        /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
-         @param     inputs   The inputs array.
-         @param     outputs  The outputs array.
-         */
-        void numberToSID(T const* inputs, T* outputs) hoa_noexcept
-        {
-            *(outputs++) = *(inputs++);
-            for(size_t i = 1ul; i <= Processor<Hoa3d, T>::Harmonics::getDecompositionOrder(); i++)
+            else
             {
-                for(size_t j = 0; j < 2ul * i + 1ul; j++)
+                for(size_t i = 0; i < m_swaps.size(); i++)
                 {
-                    if(j%2)
-                    {
-                        m_harmonics[size_t(j/2)] = *(inputs++);
-                    }
-                    else
-                    {
-                        m_harmonics[2ul * i - size_t(j/2)] = *(inputs++);
-                    }
+                    std::swap(outputs[m_swaps[i].first], outputs[m_swaps[i].second]);
                 }
-                Signal<T>::copy(i * 2ul + 1ul, m_harmonics, outputs);
-                outputs += i * 2ul + 1ul;
+                Signal<T>::mul(nharmonics, outputs, m_gains, outputs);
             }
         }
 
-        //! This method normalizes the channels from MaxN to SN3D.
-        /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
-         @param     inputs   The inputs array.
-         @param     outputs  The outputs array.
+        //! This method performs the numbering and the normalization of a block of samples.
+        /**	You should use this method for in-place or not-in-place processing of a block of samples. The inputs matrix and the outputs matrix contain the harmonics samples with one row per harmonic (harmonics × vector size). The rows are gathered and scaled in one pass, or swapped along the cycles of the permutation and then scaled for in-place processing.
+         @param     vectorsize  The vector size.
+         @param     inputs      The inputs matrix.
+         @param     outputs     The outputs matrix.
          */
-        void normalizeFromMaxN(T const* inputs, T* outputs) hoa_noexcept
+        void processBlock(const size_t vectorsize, T const* inputs, T* outputs) hoa_noexcept
         {
-            outputs[0] = inputs[0] * T(sqrt(2.));
-            outputs[1] = inputs[1] * T(sqrt(3.));
-            outputs[2] = inputs[2] * T(sqrt(3.));
-            outputs[3] = inputs[3] * T(sqrt(3.));
-            if(Processor<Hoa3d, T>::Harmonics::getDecompositionOrder() > 1ul)
+            const size_t nharmonics = Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics();
+            if(inputs != outputs)
             {
-                outputs[4] = inputs[4] * T(sqrt(15.) / 2.);
-                outputs[5] = inputs[5] * T(sqrt(15.) / 2.);
-                outputs[6] = inputs[6] * T(sqrt(5.));
-                outputs[7] = inputs[7] * T(sqrt(15.) / 2.);
-                outputs[8] = inputs[8] * T(sqrt(15.) / 2.);
-                if(Processor<Hoa3d, T>::Harmonics::getDecompositionOrder() > 2ul)
+                for(size_t i = 0; i < nharmonics; i++)
                 {
-                    outputs[9]  = inputs[9]  * T(sqrt(35. / 8.));
-                    outputs[10] = inputs[10] * T(sqrt(35.) / 3.);
-                    outputs[11] = inputs[11] * T(sqrt(224. / 45));
-                    outputs[12] = inputs[12] * T(sqrt(7.));
-                    outputs[13] = inputs[13] * T(sqrt(224. / 45));
-                    outputs[14] = inputs[14] * T(sqrt(35.) / 3.);
-                    outputs[15] = inputs[15] * T(sqrt(35. / 8.));
+                    Signal<T>::scale(vectorsize, m_gains[i], inputs + m_permutation[i] * vectorsize, outputs + i * vectorsize);
                 }
             }
-            normalizeFromN3D(outputs, outputs);
-        }
-
-        //! This method normalizes the channels from SN3D to MaxN.
-        /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
-         @param     inputs   The inputs array.
-         @param     outputs  The outputs array.
-         */
-        void normalizeToMaxN(T const* inputs, T* outputs) hoa_noexcept
-        {
-            outputs[0] = inputs[0] / T(sqrt(2.));
-            outputs[1] = inputs[1] / T(sqrt(3.));
-            outputs[2] = inputs[2] / T(sqrt(3.));
-            outputs[3] = inputs[3] / T(sqrt(3.));
-            if(Processor<Hoa3d, T>::Harmonics::getDecompositionOrder() > 1ul)
+            else
             {
-                outputs[4] = inputs[4] / T(sqrt(15.) / 2.);
-                outputs[5] = inputs[5] / T(sqrt(15.) / 2.);
-                outputs[6] = inputs[6] / T(sqrt(5.));
-                outputs[7] = inputs[7] / T(sqrt(15.) / 2.);
-                outputs[8] = inputs[8] / T(sqrt(15.) / 2.);
-                if(Processor<Hoa3d, T>::Harmonics::getDecompositionOrder() > 2ul)
+                for(size_t i = 0; i < m_swaps.size(); i++)
                 {
-                    outputs[9]  = inputs[9]  / T(sqrt(35. / 8.));
-                    outputs[10] = inputs[10] / T(sqrt(35.) / 3.);
-                    outputs[11] = inputs[11] / T(sqrt(224. / 45));
-                    outputs[12] = inputs[12] / T(sqrt(7.));
-                    outputs[13] = inputs[13] / T(sqrt(224. / 45));
-                    outputs[14] = inputs[14] / T(sqrt(35.) / 3.);
-                    outputs[15] = inputs[15] / T(sqrt(35. / 8.));
+                    T* first = outputs + m_swaps[i].first * vectorsize;
+                    std::swap_ranges(first, first + vectorsize, outputs + m_swaps[i].second * vectorsize);
                 }
-            }
-            normalizeToN3D(outputs, outputs);
-        }
-
-        //! This method normalizes the channels from N3D to SN3D.
-        /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
-         @param     inputs   The inputs array.
-         @param     outputs  The outputs array.
-         */
-        void normalizeFromN3D(T const* inputs, T* outputs) hoa_noexcept
-        {
-            T norm = T(sqrt(3.));
-            *(outputs++) = *(inputs++);
-            *(outputs++) = *(inputs++) * norm;
-            *(outputs++) = *(inputs++) * norm;
-            *(outputs++) = *(inputs++) * norm;
-            for(size_t i = 2; i <= Processor<Hoa3d, T>::Harmonics::getDecompositionOrder(); i++)
-            {
-                norm = T(sqrt(2. * T(i) + 1.));
-                for(size_t j = 0; j < i * 2ul + 1ul; j++)
+                for(size_t i = 0; i < nharmonics; i++)
                 {
-                    *(outputs++) = *(inputs++) * norm;
+                    if(m_gains[i] != T(1.))
+                    {
+                        Signal<T>::scale(vectorsize, m_gains[i], outputs + i * vectorsize);
+                    }
                 }
             }
         }
 
-        //! This method normalizes the channels from SN3D to N3D.
-        /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
-         @param     inputs   The inputs array.
-         @param     outputs  The outputs array.
-         */
-        void normalizeToN3D(T const* inputs, T* outputs) hoa_noexcept
-        {
-            T norm = T(1. / sqrt(3.));
-            *(outputs++) = *(inputs++);
-            *(outputs++) = *(inputs++) * norm;
-            *(outputs++) = *(inputs++) * norm;
-            *(outputs++) = *(inputs++) * norm;
-            for(size_t i = 2; i <= Processor<Hoa3d, T>::Harmonics::getDecompositionOrder(); i++)
-            {
-                norm = T(1. / sqrt(2. * T(i) + 1.));
-                for(size_t j = 0; j < i * 2ul + 1ul; j++)
-                {
-                    *(outputs++) = *(inputs++) * norm;
-                }
-            }
-        }
-        
         //! Retrieve the harmonic order of an input depending on the current numbering configuration.
         /** Retrieve the harmonic order of an input depending on the current numbering configuration.
          @param     index	The index of an harmonic.
@@ -0,0 +1,480 @@
+/*
+// Copyright (c) 2012-2015 Pierre Guillot, Eliott Paris & Thomas Le Meur CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef DEF_HOA_FFT_LIGHT
+#define DEF_HOA_FFT_LIGHT
+
+#include "Signal.hpp"
+#include <limits>
+
+namespace hoa
+{
+    //! The fft class performs complex discrete Fourier transforms.
+    /** The fft computes the forward discrete Fourier transform of a complex vector with the Stockham algorithm. The size of the transform must be a product of 2, 3, 5 and 7. The real parts and the imaginary parts are stored in two arrays and the twiddle factors are computed once by the constructor.
+     */
+    template <typename T> class Fft
+    {
+    private:
+        size_t              m_size;
+        std::vector<size_t> m_factors;
+        Buffer<T>           m_twiddles_real;
+        Buffer<T>           m_twiddles_imag;
+        Buffer<T>           m_roots_real;
+        Buffer<T>           m_roots_imag;
+        Buffer<T>           m_real;
+        Buffer<T>           m_imag;
+
+        static std::vector<size_t> factorize(size_t size)
+        {
+            std::vector<size_t> factors;
+            static const size_t radices[5] = {4ul, 2ul, 3ul, 5ul, 7ul};
+            for(size_t i = 0; i < 5; i++)
+            {
+                while(size > 1 && size % radices[i] == 0)
+                {
+                    factors.push_back(radices[i]);
+                    size /= radices[i];
+                }
+            }
+            if(size > 1)
+            {
+                factors.clear();
+            }
+            return factors;
+        }
+
+        // The butterflies of a stage with m groups of s transforms, the roots of unity are only used by the radix 7.
+        static void butterflies(const size_t r, const size_t m, const size_t s, const T* rr, const T* ri,
+                                const T* wr, const T* wi, const T* xr, const T* xi, T* yr, T* yi) hoa_noexcept
+        {
+            const size_t sm = s * m;
+            if(r == 2ul)
+            {
+                for(size_t p = 0; p < m; p++)
+                {
+                    const T w1r = wr[p], w1i = wi[p];
+                    for(size_t q = 0; q < s; q++)
+                    {
+                        const size_t in = q + s * p, out = q + 2 * s * p;
+                        const T ar = xr[in] - xr[in + sm], ai = xi[in] - xi[in + sm];
+                        yr[out] = xr[in] + xr[in + sm];
+                        yi[out] = xi[in] + xi[in + sm];
+                        yr[out + s] = ar * w1r - ai * w1i;
+                        yi[out + s] = ar * w1i + ai * w1r;
+                    }
+                }
+            }
+            else if(r == 3ul)
+            {
+                const T sqrt3_2 = T(0.86602540378443864676);
+                for(size_t p = 0; p < m; p++)
+                {
+                    const T w1r = wr[2*p], w1i = wi[2*p], w2r = wr[2*p+1], w2i = wi[2*p+1];
+                    for(size_t q = 0; q < s; q++)
+                    {
+                        const size_t in = q + s * p, out = q + 3 * s * p;
+                        const T t1r = xr[in + sm] + xr[in + 2 * sm], t1i = xi[in + sm] + xi[in + 2 * sm];
+                        const T t2r = xr[in + sm] - xr[in + 2 * sm], t2i = xi[in + sm] - xi[in + 2 * sm];
+                        const T m1r = xr[in] - T(0.5) * t1r, m1i = xi[in] - T(0.5) * t1i;
+                        const T m2r = sqrt3_2 * t2i, m2i = -sqrt3_2 * t2r;
+                        const T b1r = m1r + m2r, b1i = m1i + m2i;
+                        const T b2r = m1r - m2r, b2i = m1i - m2i;
+                        yr[out] = xr[in] + t1r;
+                        yi[out] = xi[in] + t1i;
+                        yr[out + s] = b1r * w1r - b1i * w1i;
+                        yi[out + s] = b1r * w1i + b1i * w1r;
+                        yr[out + 2 * s] = b2r * w2r - b2i * w2i;
+                        yi[out + 2 * s] = b2r * w2i + b2i * w2r;
+                    }
+                }
+            }
+            else if(r == 4ul)
+            {
+                for(size_t p = 0; p < m; p++)
+                {
+                    const T w1r = wr[3*p], w1i = wi[3*p], w2r = wr[3*p+1], w2i = wi[3*p+1], w3r = wr[3*p+2], w3i = wi[3*p+2];
+                    for(size_t q = 0; q < s; q++)
+                    {
+                        const size_t in = q + s * p, out = q + 4 * s * p;
+                        const T t0r = xr[in] + xr[in + 2 * sm], t0i = xi[in] + xi[in + 2 * sm];
+                        const T t1r = xr[in] - xr[in + 2 * sm], t1i = xi[in] - xi[in + 2 * sm];
+                        const T t2r = xr[in + sm] + xr[in + 3 * sm], t2i = xi[in + sm] + xi[in + 3 * sm];
+                        const T t3r = xr[in + sm] - xr[in + 3 * sm], t3i = xi[in + sm] - xi[in + 3 * sm];
+                        const T b1r = t1r + t3i, b1i = t1i - t3r;
+                        const T b2r = t0r - t2r, b2i = t0i - t2i;
+                        const T b3r = t1r - t3i, b3i = t1i + t3r;
+                        yr[out] = t0r + t2r;
+                        yi[out] = t0i + t2i;
+                        yr[out + s] = b1r * w1r - b1i * w1i;
+                        yi[out + s] = b1r * w1i + b1i * w1r;
+                        yr[out + 2 * s] = b2r * w2r - b2i * w2i;
+                        yi[out + 2 * s] = b2r * w2i + b2i * w2r;
+                        yr[out + 3 * s] = b3r * w3r - b3i * w3i;
+                        yi[out + 3 * s] = b3r * w3i + b3i * w3r;
+                    }
+                }
+            }
+            else if(r == 5ul)
+            {
+                const T c1 = T(0.30901699437494742410), c2 = T(-0.80901699437494742410);
+                const T s1 = T(0.95105651629515357212), s2 = T(0.58778525229247312917);
+                for(size_t p = 0; p < m; p++)
+                {
+                    const T* w1r = wr + 4 * p;
+                    const T* w1i = wi + 4 * p;
+                    for(size_t q = 0; q < s; q++)
+                    {
+                        const size_t in = q + s * p, out = q + 5 * s * p;
+                        const T a1r = xr[in + sm] + xr[in + 4 * sm], a1i = xi[in + sm] + xi[in + 4 * sm];
+                        const T b1r = xr[in + sm] - xr[in + 4 * sm], b1i = xi[in + sm] - xi[in + 4 * sm];
+                        const T a2r = xr[in + 2 * sm] + xr[in + 3 * sm], a2i = xi[in + 2 * sm] + xi[in + 3 * sm];
+                        const T b2r = xr[in + 2 * sm] - xr[in + 3 * sm], b2i = xi[in + 2 * sm] - xi[in + 3 * sm];
+                        const T t1r = xr[in] + c1 * a1r + c2 * a2r, t1i = xi[in] + c1 * a1i + c2 * a2i;
+                        const T t2r = xr[in] + c2 * a1r + c1 * a2r, t2i = xi[in] + c2 * a1i + c1 * a2i;
+                        const T u1r = s1 * b1r + s2 * b2r, u1i = s1 * b1i + s2 * b2i;
+                        const T u2r = s2 * b1r - s1 * b2r, u2i = s2 * b1i - s1 * b2i;
+                        // The outputs k and 5 - k are t ∓ i·u.
+                        const T y1r = t1r + u1i, y1i = t1i - u1r, y4r = t1r - u1i, y4i = t1i + u1r;
+                        const T y2r = t2r + u2i, y2i = t2i - u2r, y3r = t2r - u2i, y3i = t2i + u2r;
+                        yr[out] = xr[in] + a1r + a2r;
+                        yi[out] = xi[in] + a1i + a2i;
+                        yr[out + s] = y1r * w1r[0] - y1i * w1i[0];
+                        yi[out + s] = y1r * w1i[0] + y1i * w1r[0];
+                        yr[out + 2 * s] = y2r * w1r[1] - y2i * w1i[1];
+                        yi[out + 2 * s] = y2r * w1i[1] + y2i * w1r[1];
+                        yr[out + 3 * s] = y3r * w1r[2] - y3i * w1i[2];
+                        yi[out + 3 * s] = y3r * w1i[2] + y3i * w1r[2];
+                        yr[out + 4 * s] = y4r * w1r[3] - y4i * w1i[3];
+                        yi[out + 4 * s] = y4r * w1i[3] + y4i * w1r[3];
+                    }
+                }
+            }
+            else
+            {
+                for(size_t p = 0; p < m; p++)
+                {
+                    for(size_t q = 0; q < s; q++)
+                    {
+                        const size_t in = q + s * p, out = q + r * s * p;
+                        for(size_t k = 0; k < r; k++)
+                        {
+                            T br = xr[in], bi = xi[in];
+                            size_t index = 0;
+                            for(size_t j = 1; j < r; j++)
+                            {
+                                index = (index + k < r) ? index + k : index + k - r;
+                                br += xr[in + j * sm] * rr[index] - xi[in + j * sm] * ri[index];
+                                bi += xr[in + j * sm] * ri[index] + xi[in + j * sm] * rr[index];
+                            }
+                            if(k)
+                            {
+                                const T twr = wr[(r - 1) * p + k - 1], twi = wi[(r - 1) * p + k - 1];
+                                yr[out + k * s] = br * twr - bi * twi;
+                                yi[out + k * s] = br * twi + bi * twr;
+                            }
+                            else
+                            {
+                                yr[out] = br;
+                                yi[out] = bi;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+    public:
+
+        //! The fft constructor.
+        /**	The fft constructor computes the factors and the twiddle factors of the transform.
+         @param     size   The size of the transform.
+         */
+        Fft(const size_t size = 0) :
+        m_size(size),
+        m_factors(factorize(size)),
+        m_roots_real(12),
+        m_roots_imag(12),
+        m_real(size),
+        m_imag(size)
+        {
+            for(size_t i = 0; i < 5; i++)
+            {
+                m_roots_real[i] = T(cos(HOA_2PI * double(i) / 5.));
+                m_roots_imag[i] = T(-sin(HOA_2PI * double(i) / 5.));
+            }
+            for(size_t i = 0; i < 7; i++)
+            {
+                m_roots_real[i + 5] = T(cos(HOA_2PI * double(i) / 7.));
+                m_roots_imag[i + 5] = T(-sin(HOA_2PI * double(i) / 7.));
+            }
+            size_t ntwiddles = 0, n = m_size;
+            for(size_t f = 0; f < m_factors.size(); f++)
+            {
+                n /= m_factors[f];
+                ntwiddles += n * (m_factors[f] - 1);
+            }
+            m_twiddles_real.resize(ntwiddles);
+            m_twiddles_imag.resize(ntwiddles);
+            size_t offset = 0, s = 1;
+            n = m_size;
+            for(size_t f = 0; f < m_factors.size(); f++)
+            {
+                const size_t r = m_factors[f];
+                const size_t m = n / r;
+                for(size_t p = 0; p < m; p++)
+                {
+                    for(size_t k = 1; k < r; k++)
+                    {
+                        const double angle = HOA_2PI * double(s * p * k) / double(m_size);
+                        m_twiddles_real[offset] = T(cos(angle));
+                        m_twiddles_imag[offset] = T(-sin(angle));
+                        offset++;
+                    }
+                }
+                n = m;
+                s *= r;
+            }
+        }
+
+        //! Check if a size is supported.
+        /** Check if the size is a product of 2, 3, 5 and 7.
+         @param     size   The size of the transform.
+         @return    true if the size is supported, otherwise false.
+         */
+        static bool isSupported(const size_t size)
+        {
+            return size == 1 || !factorize(size).empty();
+        }
+
+        //! Retrieve the size of the transform.
+        /** Retrieve the size of the transform.
+         @return    The size of the transform.
+         */
+        inline size_t getSize() const hoa_noexcept
+        {
+            return m_size;
+        }
+
+        //! Retrieve the cost of the transform.
+        /** Retrieve an estimation of the number of real operations of the transform.
+         @return    The cost of the transform.
+         */
+        inline double getCost() const hoa_noexcept
+        {
+            double cost = 0.;
+            for(size_t i = 0; i < m_factors.size(); i++)
+            {
+                const size_t r = m_factors[i];
+                cost += (r == 2ul) ? 5. : ((r == 3ul) ? 15. : ((r == 4ul) ? 9. : ((r == 5ul) ? 16. : 6. * double(r))));
+            }
+            return cost * double(m_size);
+        }
+
+        //! Perform the forward transform.
+        /** Perform in-place the forward transform \f$X_k = \sum_{n=0}^{N-1} x_n e^{-2i\pi kn/N}\f$.
+         @param     real   The real parts.
+         @param     imag   The imaginary parts.
+         */
+        void forward(T* real, T* imag) hoa_noexcept
+        {
+            T* xr = real;
+            T* xi = imag;
+            T* yr = m_real;
+            T* yi = m_imag;
+            size_t n = m_size, s = 1, offset = 0;
+            for(size_t f = 0; f < m_factors.size(); f++)
+            {
+                const size_t r = m_factors[f];
+                const size_t m = n / r;
+                const size_t roots = (r == 7ul) ? 5ul : 0ul;
+                butterflies(r, m, s, m_roots_real + roots, m_roots_imag + roots, m_twiddles_real + offset, m_twiddles_imag + offset, xr, xi, yr, yi);
+                offset += m * (r - 1);
+                std::swap(xr, yr);
+                std::swap(xi, yi);
+                n = m;
+                s *= r;
+            }
+            if(xr != real)
+            {
+                Signal<T>::copy(m_size, xr, real);
+                Signal<T>::copy(m_size, xi, imag);
+            }
+        }
+    };
+
+    //! The fft projection class evaluates circular harmonics on a regular circle.
+    /** The fft projection replaces the projection matrix of the circular harmonics on a set of points by a discrete Fourier transform when the points are equally spaced on the circle. The rotation of the points and the gains of the harmonics are folded into one complex factor per degree. The values of the points are real, so for an even number of points the even and the odd points are computed together by a complex transform of half the size. The projection is only enabled when the matrix matches a regular layout and when the transform is cheaper than the matrix product.
+     */
+    template <typename T> class FftProjection
+    {
+    private:
+        size_t      m_order;
+        bool        m_enabled;
+        bool        m_half;
+        Fft<T>      m_fft;
+        Buffer<T>   m_factors;
+        Buffer<T>   m_shifts_real;
+        Buffer<T>   m_shifts_imag;
+        Buffer<T>   m_real;
+        Buffer<T>   m_imag;
+
+    public:
+
+        //! The fft projection constructor.
+        /**	The fft projection constructor creates a disabled projection.
+         */
+        FftProjection() :
+        m_order(0),
+        m_enabled(false),
+        m_half(false)
+        {
+            ;
+        }
+
+        //! Compute the projection from a projection matrix.
+        /** Compute the projection from a matrix with one row per point and one column per harmonic. The row \f$n\f$ of the matrix must be \f$g_0\f$ for the harmonic \f$0\f$, \f$g_l\sin{(l\theta_n)}\f$ and \f$g_l\cos{(l\theta_n)}\f$ for the harmonics \f$2l-1\f$ and \f$2l\f$ with \f$\theta_n = \theta_0 + 2\pi n / N\f$ up to the rounding errors of the matrix, otherwise the projection is disabled.
+         @param     order       The order of decomposition.
+         @param     npoints     The number of points.
+         @param     matrix      The projection matrix.
+         @return    true if the projection is enabled, otherwise false.
+         */
+        bool compute(const size_t order, const size_t npoints, const T* matrix)
+        {
+            const size_t nharmonics = order * 2 + 1;
+            m_enabled = false;
+            m_order   = order;
+            if(npoints < nharmonics || !Fft<T>::isSupported(npoints))
+            {
+                return false;
+            }
+            // The even and the odd points are computed by one transform of half the size.
+            const bool half = (npoints % 2 == 0) && Fft<T>::isSupported(npoints / 2);
+            Fft<T> fft(half ? npoints / 2 : npoints);
+            // The cost counts the real operations of the transform and of the packing, the matrix product needs one
+            // multiply-add per point and per harmonic and runs about four times as many operations per cycle.
+            const double cost = fft.getCost() + (half ? 10. * double(npoints) : 0.);
+            if(cost >= 4. * double(npoints * nharmonics))
+            {
+                return false;
+            }
+            m_factors.resize(nharmonics);
+            m_factors[0] = matrix[0];
+            for(size_t l = 1; l <= order; l++)
+            {
+                m_factors[2*l-1] = matrix[2*l-1];
+                m_factors[2*l]   = matrix[2*l];
+            }
+            T maximum = 0;
+            for(size_t i = 0; i < npoints * nharmonics; i++)
+            {
+                maximum = std::max(maximum, T(fabs(matrix[i])));
+            }
+            // The matrix of a regular layout only differs from the transform by the rounding errors of its computation.
+            const double tolerance = 4. * double(std::numeric_limits<T>::epsilon()) * double(maximum) * double(npoints);
+            for(size_t i = 1; i < npoints; i++)
+            {
+                const T* row = matrix + i * nharmonics;
+                if(fabs(double(row[0]) - double(m_factors[0])) > tolerance)
+                {
+                    return false;
+                }
+                for(size_t l = 1; l <= order; l++)
+                {
+                    const double angle = HOA_2PI * double(l * i % npoints) / double(npoints);
+                    const double c = cos(angle), s = sin(angle);
+                    const double gcos = double(m_factors[2*l]) * c - double(m_factors[2*l-1]) * s;
+                    const double gsin = double(m_factors[2*l-1]) * c + double(m_factors[2*l]) * s;
+                    if(fabs(double(row[2*l-1]) - gsin) > tolerance || fabs(double(row[2*l]) - gcos) > tolerance)
+                    {
+                        return false;
+                    }
+                }
+            }
+            m_half = half;
+            m_fft  = fft;
+            if(m_half)
+            {
+                // The shifts of the odd points.
+                m_shifts_real.resize(npoints / 2);
+                m_shifts_imag.resize(npoints / 2);
+                for(size_t k = 0; k < npoints / 2; k++)
+                {
+                    m_shifts_real[k] = T(cos(HOA_2PI * double(k) / double(npoints)));
+                    m_shifts_imag[k] = T(-sin(HOA_2PI * double(k) / double(npoints)));
+                }
+            }
+            m_real.resize(fft.getSize());
+            m_imag.resize(fft.getSize());
+            m_enabled = true;
+            return true;
+        }
+
+        //! Check if the projection is enabled.
+        /** Check if the projection matrix matches a regular layout and uses the transform.
+         @return    true if the projection is enabled, otherwise false.
+         */
+        inline bool isEnabled() const hoa_noexcept
+        {
+            return m_enabled;
+        }
+
+        //! Perform the projection.
+        /** Perform the projection of the harmonics on the points. The projection must be enabled.
+         @param     inputs  The inputs array that contains the samples of the harmonics.
+         @param     outputs The outputs array that contains the values of the points.
+         */
+        void process(const T* inputs, T* outputs) hoa_noexcept
+        {
+            const size_t size = m_fft.getSize();
+            Signal<T>::clear(size, m_real);
+            Signal<T>::clear(size, m_imag);
+            if(!m_half)
+            {
+                m_real[0] = inputs[0] * m_factors[0];
+                for(size_t l = 1; l <= m_order; l++)
+                {
+                    // The conjugate of (cos - i·sin)·(gcos + i·gsin).
+                    const T sinl = inputs[2*l-1], cosl = inputs[2*l];
+                    m_real[l] = cosl * m_factors[2*l] + sinl * m_factors[2*l-1];
+                    m_imag[l] = sinl * m_factors[2*l] - cosl * m_factors[2*l-1];
+                }
+                m_fft.forward(m_real, m_imag);
+                Signal<T>::copy(size, m_real, outputs);
+                return;
+            }
+
+            // The spectrum Z of the real values is hermitian, Z(k) = X(k) / 2 and Z(N - k) = conj(X(k)) / 2.
+            // The bin k < N / 2 of the half transform is Z(k) + Z(k + N / 2) + i·(Z(k) - Z(k + N / 2))·shift(k),
+            // its real part gives the even points and its imaginary part gives the odd points.
+            const T x0 = inputs[0] * m_factors[0];
+            m_real[0] = x0;
+            m_imag[0] = x0;
+            for(size_t l = 1; l <= m_order; l++)
+            {
+                const T sinl = inputs[2*l-1], cosl = inputs[2*l];
+                const T zr = T(0.5) * (cosl * m_factors[2*l] + sinl * m_factors[2*l-1]);
+                const T zi = T(0.5) * (sinl * m_factors[2*l] - cosl * m_factors[2*l-1]);
+                const T pr = zr * m_shifts_real[l] - zi * m_shifts_imag[l];
+                const T pi = zr * m_shifts_imag[l] + zi * m_shifts_real[l];
+                m_real[l] += zr - pi;
+                m_imag[l] += zi + pr;
+                const size_t j = size - l;
+                const T qr = zr * m_shifts_real[j] + zi * m_shifts_imag[j];
+                const T qi = zr * m_shifts_imag[j] - zi * m_shifts_real[j];
+                m_real[j] += zr + qi;
+                m_imag[j] += -zi - qr;
+            }
+            m_fft.forward(m_real, m_imag);
+            for(size_t i = 0; i < size; i++)
+            {
+                outputs[2*i]   = m_real[i];
+                outputs[2*i+1] = m_imag[i];
+            }
+        }
+    };
+}
+
+#endif
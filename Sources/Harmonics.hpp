@@ -10,6 +10,10 @@
 #include "Math.hpp"
 #include "Signal.hpp"
 
+#if (__cplusplus > 199711L)
+#include <mutex>
+#endif
+
 namespace hoa
 {
     //! The harmonic class owns basic harmonics ordering informations.
@@ -294,7 +298,7 @@ namespace hoa
          */
         inline size_t getDegree() const hoa_noexcept
         {
-            return size_t(sqrt(float(m_index)));
+            return getDegree(m_index);
         }
 
         //! Get the order of the harmonic.
@@ -303,7 +307,7 @@ namespace hoa
          */
         inline long getOrder() const hoa_noexcept
         {
-            return long(m_index) - long(getDegree() * (getDegree() + 1));
+            return getOrder(m_index);
         }
 
         //! Get the name of the harmonic.
@@ -340,7 +344,16 @@ namespace hoa
          */
         static inline size_t getDegree(const size_t index) hoa_noexcept
         {
-            return size_t(sqrt(float(index)));
+            size_t degree = size_t(std::sqrt(double(index)));
+            while(degree * degree > index)
+            {
+                --degree;
+            }
+            while((degree + 1) * (degree + 1) <= index)
+            {
+                ++degree;
+            }
+            return degree;
         }
 
         //! Get the order of an harmonic with an index.
@@ -350,7 +363,8 @@ namespace hoa
          */
         static inline long getOrder(const size_t index) hoa_noexcept
         {
-            return long(index) - (long(sqrt(float(index))) * (long(sqrt(float(index))) + 1));
+            const size_t degree = getDegree(index);
+            return long(index) - long(degree * (degree + 1));
         }
 
         //! Get the index of an harmonic with its degree and its order.
@@ -406,8 +420,168 @@ namespace hoa
 
 #endif
 
-}
+    //! The harmonic table owns the informations of all the harmonics of an order of decomposition.
+    /** The harmonic table stores the degrees, the orders, the normalizations and the semi-normalizations of the harmonics in contiguous arrays. The tables are immutable, created once per dimension, order of decomposition and precision and shared by all the processors.
+     */
+    template <Dimension D, typename T> class HarmonicTable
+    {
+    private:
+        const size_t        m_order_of_decomposition;
+        const size_t        m_number_of_harmonics;
+        std::vector<size_t> m_degrees;
+        std::vector<long>   m_orders;
+        std::vector<T>      m_normalizations;
+        std::vector<T>      m_semi_normalizations;
+
+        HarmonicTable(const size_t order) :
+        m_order_of_decomposition(order),
+        m_number_of_harmonics(Harmonic<D, T>::getNumberOfHarmonics(order))
+        {
+            for(size_t i = 0; i < m_number_of_harmonics; i++)
+            {
+                const Harmonic<D, T> harmonic(i);
+                m_degrees.push_back(harmonic.getDegree());
+                m_orders.push_back(harmonic.getOrder());
+                m_normalizations.push_back(harmonic.getNormalization());
+                m_semi_normalizations.push_back(harmonic.getSemiNormalization());
+            }
+        }
+
+        HarmonicTable(const HarmonicTable& other);
+        HarmonicTable& operator=(const HarmonicTable& other);
+
+        class Registry
+        {
+        public:
+            std::vector<HarmonicTable*> tables;
+            ~Registry()
+            {
+                for(size_t i = 0; i < tables.size(); i++)
+                {
+                    delete tables[i];
+                }
+            }
+        };
 
+    public:
+
+        //! Get the harmonic table of an order of decomposition.
+        /** The method returns the shared harmonic table of an order of decomposition, the table is created the first time it is requested. The method is thread-safe with C++11 and later.
+         @param order   The order of decomposition.
+         @return        The harmonic table.
+         */
+        static const HarmonicTable& get(const size_t order)
+        {
+#if (__cplusplus > 199711L)
+            static std::mutex mutex;
+            std::lock_guard<std::mutex> lock(mutex);
 #endif
+            static Registry registry;
+            if(registry.tables.size() <= order)
+            {
+                registry.tables.resize(order + 1, hoa_nullptr);
+            }
+            if(!registry.tables[order])
+            {
+                registry.tables[order] = new HarmonicTable(order);
+            }
+            return *registry.tables[order];
+        }
 
+        //! Retrieve the order of decomposition.
+        /** Retrieve the order of decomposition of the table.
+         @return The order.
+         */
+        inline size_t getDecompositionOrder() const hoa_noexcept
+        {
+            return m_order_of_decomposition;
+        }
 
+        //! Retrieve the number of harmonics.
+        /** Retrieve the number of harmonics of the table.
+         @return The number of harmonics.
+         */
+        inline size_t getNumberOfHarmonics() const hoa_noexcept
+        {
+            return m_number_of_harmonics;
+        }
+
+        //! Get the degree of an harmonic.
+        /** The method returns the degree of an harmonic.
+         @param index   The index of the harmonic.
+         @return        The degree.
+         */
+        inline size_t getDegree(const size_t index) const hoa_noexcept
+        {
+            return m_degrees[index];
+        }
+
+        //! Get the order of an harmonic.
+        /** The method returns the order of an harmonic.
+         @param index   The index of the harmonic.
+         @return        The order.
+         */
+        inline long getOrder(const size_t index) const hoa_noexcept
+        {
+            return m_orders[index];
+        }
+
+        //! Get the normalization of an harmonic.
+        /** The method returns the normalization of an harmonic.
+         @param index   The index of the harmonic.
+         @return        The normalization.
+         */
+        inline T getNormalization(const size_t index) const hoa_noexcept
+        {
+            return m_normalizations[index];
+        }
+
+        //! Get the semi-normalization of an harmonic.
+        /** The method returns the semi-normalization of an harmonic.
+         @param index   The index of the harmonic.
+         @return        The semi-normalization.
+         */
+        inline T getSemiNormalization(const size_t index) const hoa_noexcept
+        {
+            return m_semi_normalizations[index];
+        }
+
+        //! Get the degrees of the harmonics.
+        /** The method returns the degrees of all the harmonics in the ACN ordering.
+         @return        The degrees.
+         */
+        inline const size_t* getDegrees() const hoa_noexcept
+        {
+            return &m_degrees[0];
+        }
+
+        //! Get the orders of the harmonics.
+        /** The method returns the orders of all the harmonics in the ACN ordering.
+         @return        The orders.
+         */
+        inline const long* getOrders() const hoa_noexcept
+        {
+            return &m_orders[0];
+        }
+
+        //! Get the normalizations of the harmonics.
+        /** The method returns the normalizations of all the harmonics.
+         @return        The normalizations.
+         */
+        inline const T* getNormalizations() const hoa_noexcept
+        {
+            return &m_normalizations[0];
+        }
+
+        //! Get the semi-normalizations of the harmonics.
+        /** The method returns the semi-normalizations of all the harmonics.
+         @return        The semi-normalizations.
+         */
+        inline const T* getSemiNormalizations() const hoa_noexcept
+        {
+            return &m_semi_normalizations[0];
+        }
+    };
+}
+
+#endif
@@ -18,10 +18,16 @@
 #include "Projector.hpp"
 #include "Recomposer.hpp"
 #include "Scope.hpp"
+#include "Activity.hpp"
 #include "Wider.hpp"
 #include "Source.hpp"
 #include "Exchanger.hpp"
 #include "Tools.hpp"
+#include "Ring.hpp"
+#include "Pool.hpp"
+#include "Snapshot.hpp"
+#include "Workers.hpp"
+#include "Fft.hpp"
 
 #endif
 
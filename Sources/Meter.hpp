@@ -9,9 +9,137 @@
 
 #include "Planewaves.hpp"
 #include "Voronoi.hpp"
+#include "Snapshot.hpp"
 
 namespace hoa
 {
+    //! The true peak class estimates the inter-sample peaks of a set of channels.
+    /** The true peak class oversamples the channels 4 times with a polyphase interpolation filter of 12 taps per phase and retrieves the highest absolute value of the interpolated samples, as recommended by the ITU-R BS.1770 for the measure of the true peak. The filter is a windowed sinc normalized so each phase has a unity gain for a constant signal. The last samples of each channel are kept from one block to another, the interpolated samples are then delayed by 6 samples. The working buffer is allocated by the constructor for a maximum vector size and the larger blocks are processed in several parts, so the processing never allocates memory.
+     */
+    template <typename T> class TruePeak
+    {
+    private:
+        static const size_t m_number_of_phases = 4ul;
+        static const size_t m_number_of_taps   = 12ul;
+
+        size_t      m_number_of_channels;
+        size_t      m_vector_size;
+        Buffer<T>   m_filter;
+        Buffer<T>   m_history;
+        Buffer<T>   m_buffer;
+
+    public:
+
+        //! The true peak constructor.
+        /**	The true peak constructor computes the interpolation filter, allocates the working buffer and clears the history of the channels.
+         @param     numberOfChannels    The number of channels.
+         @param     vectorSize          The maximum vector size processed at once, at least 1.
+         */
+        TruePeak(const size_t numberOfChannels = 0ul, const size_t vectorSize = 256ul) hoa_noexcept :
+        m_number_of_channels(numberOfChannels),
+        m_vector_size(vectorSize ? vectorSize : 1ul),
+        m_filter((m_number_of_phases - 1ul) * m_number_of_taps),
+        m_history(numberOfChannels * (m_number_of_taps - 1ul)),
+        m_buffer(m_number_of_taps - 1ul + m_vector_size + 3ul)
+        {
+            const T half = T(m_number_of_taps) * T(0.5) + T(0.5);
+            for(size_t i = 1; i < m_number_of_phases; i++)
+            {
+                T* filter = m_filter + (i - 1ul) * m_number_of_taps;
+                T sum = 0;
+                for(size_t j = 0; j < m_number_of_taps; j++)
+                {
+                    // The taps are reversed so the filter is a dot product with the oldest sample first
+                    const T time = T(j) - T(m_number_of_taps / 2ul - 1ul) - T(i) / T(m_number_of_phases);
+                    const T sinc = (time != 0) ? T(sin(HOA_PI * time) / (HOA_PI * time)) : T(1.);
+                    filter[j] = sinc * T(0.5 + 0.5 * cos(HOA_PI * time / half));
+                    sum += filter[j];
+                }
+                Signal<T>::scale(m_number_of_taps, T(1.) / sum, filter);
+            }
+            Signal<T>::clear(m_number_of_taps - 1ul + m_vector_size + 3ul, m_buffer);
+            clear();
+        }
+
+        //! Retrieve the number of channels.
+        /** Retrieve the number of channels.
+         @return The number of channels.
+         */
+        inline size_t getNumberOfChannels() const hoa_noexcept
+        {
+            return m_number_of_channels;
+        }
+
+        //! Clear the history.
+        /** Clear the last samples kept for each channel.
+         */
+        inline void clear() hoa_noexcept
+        {
+            if(m_number_of_channels)
+            {
+                Signal<T>::clear(m_number_of_channels * (m_number_of_taps - 1ul), m_history);
+            }
+        }
+
+        //! Retrieve the maximum vector size.
+        /** Retrieve the maximum number of samples processed at once, the larger blocks are processed in several parts.
+         @return The maximum vector size.
+         */
+        inline size_t getVectorSize() const hoa_noexcept
+        {
+            return m_vector_size;
+        }
+
+        //! Retrieve the true peak of a block.
+        /** Oversample a block of samples of a channel and retrieve the highest absolute value of the interpolated samples. The original samples are not taken into account, the true peak is the maximum of the returned value and the peak of the block.
+         @param     index       The index of the channel.
+         @param     vectorsize  The vector size.
+         @param     input       The samples of the channel.
+         @return    The highest absolute value of the interpolated samples.
+         */
+        T process(const size_t index, const size_t vectorsize, const T* input) hoa_noexcept
+        {
+            const size_t nhistory = m_number_of_taps - 1ul;
+            T* history = m_history + index * nhistory;
+            const T* filter1 = m_filter;
+            const T* filter2 = m_filter + m_number_of_taps;
+            const T* filter3 = m_filter + m_number_of_taps * 2ul;
+            T peak = 0;
+            for(size_t offset = 0; offset < vectorsize; offset += m_vector_size)
+            {
+                const size_t count = (vectorsize - offset < m_vector_size) ? vectorsize - offset : m_vector_size;
+                Signal<T>::copy(nhistory, history, m_buffer);
+                Signal<T>::copy(count, input + offset, m_buffer + nhistory);
+                for(size_t i = 0; i < count; i += 4ul)
+                {
+                    // Four interpolated samples of each phase are computed at once so the sums are independent
+                    const T* buffer = m_buffer + i;
+                    T sum1[4] = {0, 0, 0, 0}, sum2[4] = {0, 0, 0, 0}, sum3[4] = {0, 0, 0, 0};
+                    for(size_t j = 0; j < m_number_of_taps; j++)
+                    {
+                        const T factor1 = filter1[j], factor2 = filter2[j], factor3 = filter3[j];
+                        for(size_t k = 0; k < 4ul; k++)
+                        {
+                            sum1[k] += factor1 * buffer[j + k];
+                            sum2[k] += factor2 * buffer[j + k];
+                            sum3[k] += factor3 * buffer[j + k];
+                        }
+                    }
+                    const size_t size = (count - i < 4ul) ? count - i : 4ul;
+                    for(size_t k = 0; k < size; k++)
+                    {
+                        const T value1 = fabs(sum1[k]), value2 = fabs(sum2[k]), value3 = fabs(sum3[k]);
+                        peak = value1 > peak ? value1 : peak;
+                        peak = value2 > peak ? value2 : peak;
+                        peak = value3 > peak ? value3 : peak;
+                    }
+                }
+                Signal<T>::copy(nhistory, m_buffer + count, history);
+            }
+            return peak;
+        }
+    };
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
     //! The meter class.
     /** The meter should be used to draw an hoa meter.
@@ -23,10 +151,49 @@ namespace hoa
     private:
         size_t   m_ramp;
         size_t   m_vector_size;
-        T*      m_channels_peaks;
-        T*      m_channels_azimuth_mapped;
-        T*      m_channels_azimuth_width;
-        size_t*  m_over_leds;
+        Buffer<T> m_channels_peaks;
+        Buffer<T> m_channels_azimuth_mapped;
+        Buffer<T> m_channels_azimuth_width;
+        std::vector<size_t> m_over_leds;
+        Buffer<T>   m_channels_energy;
+        Buffer<T>   m_channels_power;
+        Buffer<T>   m_channels_true_peaks;
+        size_t      m_count;
+        T           m_sample_rate;
+        T           m_peak_release;
+        T           m_rms_time;
+        bool        m_true_peak_enabled;
+        TruePeak<T> m_true_peak;
+#if (__cplusplus > 199711L)
+        size_t      m_time;
+        Snapshot<T> m_snapshot;
+
+        inline void publish() hoa_noexcept
+        {
+            const size_t size = Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves();
+            T* values = m_snapshot.write();
+            for(size_t i = 0; i < size; i++)
+            {
+                values[i]               = m_channels_peaks[i];
+                values[i + size]        = sqrt(m_channels_power[i]);
+                values[i + size * 2]    = m_channels_peaks[i] >= 1. ? T(1.) : T(0.);
+                values[i + size * 3]    = m_channels_true_peaks[i];
+            }
+            m_snapshot.publish(m_time);
+        }
+#endif
+
+        static inline T getDecibels(const T value) hoa_noexcept
+        {
+            if(value > 0.)
+            {
+                return 20. * log10(value);
+            }
+            else
+            {
+                return -90.;
+            }
+        }
 
     public:
         //! The meter constructor.
@@ -34,14 +201,30 @@ namespace hoa
          @param     numberOfPlanewaves      The number of channels.
          */
         Meter(size_t numberOfPlanewaves) hoa_noexcept :
-        Processor<Hoa2d, T>::Planewaves(numberOfPlanewaves)
+        Processor<Hoa2d, T>::Planewaves(numberOfPlanewaves),
+        m_true_peak(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves())
+#if (__cplusplus > 199711L)
+        , m_time(0)
+        , m_snapshot(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves() * 4)
+#endif
         {
             m_ramp                      = 0;
             m_vector_size               = 0;
-            m_channels_peaks            = Signal<T>::alloc(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
-            m_channels_azimuth_width    = Signal<T>::alloc(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
-            m_channels_azimuth_mapped   = Signal<T>::alloc(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
-            m_over_leds                 = new size_t[Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves()];
+            m_channels_peaks.resize(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
+            m_channels_azimuth_width.resize(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
+            m_channels_azimuth_mapped.resize(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
+            m_over_leds.resize(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
+            m_channels_energy.resize(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
+            m_channels_power.resize(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
+            m_channels_true_peaks.resize(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
+            Signal<T>::clear(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(), m_channels_energy);
+            Signal<T>::clear(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(), m_channels_power);
+            Signal<T>::clear(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(), m_channels_true_peaks);
+            m_count             = 0;
+            m_sample_rate       = 44100.;
+            m_peak_release      = 0.;
+            m_rms_time          = 0.;
+            m_true_peak_enabled = false;
             for(size_t i = 0; i < Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(); i++)
             {
                 m_channels_peaks[i] = 0;
@@ -49,17 +232,6 @@ namespace hoa
             }
         }
 
-        //! The destructor.
-        /** The destructor free the memory.
-         */
-        ~Meter()
-        {
-            Signal<T>::free(m_channels_peaks);
-            Signal<T>::free(m_channels_azimuth_width);
-            Signal<T>::free(m_channels_azimuth_mapped);
-            delete [] m_over_leds;
-        }
-
         //! Set the vector size.
         /** Set the vector size.
         @param vectorSize    The new vector size.
@@ -68,6 +240,8 @@ namespace hoa
         {
             m_vector_size   = vectorSize;
             m_ramp          = 0;
+            Signal<T>::clear(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(), m_channels_energy);
+            m_count = 0;
         }
 
         //! Get the vector size.
@@ -157,14 +331,27 @@ namespace hoa
          */
         inline T getPlanewaveEnergy(const size_t index) const hoa_noexcept
         {
-            if(m_channels_peaks[index] > 0.)
-            {
-                return 20. * log10(m_channels_peaks[index]);
-            }
-            else
-            {
-                return -90.;
-            }
+            return getDecibels(m_channels_peaks[index]);
+        }
+
+        //! Get the channel root mean square.
+        /** Get the channel root mean square in dB.
+        @param index    The index of the channel.
+        @return The channel root mean square.
+         */
+        inline T getPlanewaveRms(const size_t index) const hoa_noexcept
+        {
+            return getDecibels(sqrt(m_channels_power[index]));
+        }
+
+        //! Get the channel true peak.
+        /** Get the channel true peak in dB. The true peak is the peak if the true peak measure is disabled or if the meter is processed sample by sample.
+        @param index    The index of the channel.
+        @return The channel true peak.
+         */
+        inline T getPlanewaveTruePeak(const size_t index) const hoa_noexcept
+        {
+            return getDecibels(m_channels_true_peaks[index]);
         }
 
         //! Get the channel overLed state.
@@ -177,6 +364,17 @@ namespace hoa
             return m_over_leds[index];
         }
 
+#if (__cplusplus > 199711L)
+        //! Get the snapshot of the meter.
+        /** Get the snapshot that the process method publishes at the end of each period of the vector size and that the processBlock method publishes at the end of each block. A graphical interface or a monitoring thread should poll the snapshot instead of calling getPlanewaveEnergy, getPlanewaveOverLed and tick while the audio thread processes. A set of values contains the peaks of the channels, then the root mean squares of the channels, then the overload states of the channels (1 if the peak reached 0 dB, otherwise 0) and then the true peaks of the channels, its time is the number of samples processed.
+         @return The snapshot of the meter.
+         */
+        inline Snapshot<T>& getSnapshot() hoa_noexcept
+        {
+            return m_snapshot;
+        }
+#endif
+
         //! This method update the overLed state of the channels.
         /** This method update the overLed state of the channels.
         @param value    A no-NULL value to activate the overLed state of a channel
@@ -202,6 +400,28 @@ namespace hoa
          */
         inline void process(const T* inputs) hoa_noexcept
         {
+            if(m_ramp == m_vector_size)
+            {
+                const T count = m_count ? T(m_count) : T(1.);
+                for(size_t i = 0; i < Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(); i++)
+                {
+                    m_channels_power[i]         = m_channels_energy[i] / count;
+                    m_channels_true_peaks[i]    = m_channels_peaks[i];
+                    m_channels_energy[i]        = 0;
+                }
+                m_count = 0;
+#if (__cplusplus > 199711L)
+                publish();
+#endif
+            }
+            for(size_t i = 0; i < Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(); i++)
+            {
+                m_channels_energy[i] += inputs[i] * inputs[i];
+            }
+            m_count++;
+#if (__cplusplus > 199711L)
+            m_time++;
+#endif
             if(m_ramp++ == m_vector_size)
             {
                 m_ramp = 0;
@@ -223,6 +443,122 @@ namespace hoa
             }
         }
 
+        //! Set the sample rate.
+        /** Set the sample rate used to compute the ballistics of the block processing.
+        @param sampleRate   The sample rate.
+         */
+        inline void setSampleRate(const T sampleRate) hoa_noexcept
+        {
+            m_sample_rate = sampleRate > 0. ? sampleRate : T(44100.);
+        }
+
+        //! Get the sample rate.
+        /** Get the sample rate used to compute the ballistics of the block processing.
+        @return The sample rate.
+         */
+        inline T getSampleRate() const hoa_noexcept
+        {
+            return m_sample_rate;
+        }
+
+        //! Set the peak release.
+        /** Set the time in seconds that the peaks of the block processing take to decrease by a factor e (about 8.7 dB). A time of 0 means that the peaks are the peaks of the last block only.
+        @param time     The peak release.
+         */
+        inline void setPeakRelease(const T time) hoa_noexcept
+        {
+            m_peak_release = time > 0. ? time : T(0.);
+        }
+
+        //! Get the peak release.
+        /** Get the time in seconds that the peaks of the block processing take to decrease by a factor e.
+        @return The peak release.
+         */
+        inline T getPeakRelease() const hoa_noexcept
+        {
+            return m_peak_release;
+        }
+
+        //! Set the root mean square time.
+        /** Set the time constant in seconds of the integration of the root mean squares of the block processing. A time of 0 means that the root mean squares are the root mean squares of the last block only.
+        @param time     The root mean square time.
+         */
+        inline void setRmsTime(const T time) hoa_noexcept
+        {
+            m_rms_time = time > 0. ? time : T(0.);
+        }
+
+        //! Get the root mean square time.
+        /** Get the time constant in seconds of the integration of the root mean squares of the block processing.
+        @return The root mean square time.
+         */
+        inline T getRmsTime() const hoa_noexcept
+        {
+            return m_rms_time;
+        }
+
+        //! Enable or disable the true peak measure.
+        /** Enable or disable the measure of the inter-sample peaks with a 4 times oversampling in the block processing. The measure costs 36 multiplications per sample and per channel.
+        @param state    The state of the true peak measure.
+         */
+        inline void setTruePeak(const bool state) hoa_noexcept
+        {
+            if(state && !m_true_peak_enabled)
+            {
+                m_true_peak.clear();
+            }
+            m_true_peak_enabled = state;
+        }
+
+        //! Get the state of the true peak measure.
+        /** Get the state of the measure of the inter-sample peaks in the block processing.
+        @return The state of the true peak measure.
+         */
+        inline bool getTruePeak() const hoa_noexcept
+        {
+            return m_true_peak_enabled;
+        }
+
+        //! This method update the meter with a block of samples.
+        /** This method computes the peaks, the root mean squares and, if enabled, the true peaks of the channels for a block of samples and smoothes them with the peak release and the root mean square time. It should be preferred to the sample by sample processing, the vector size and the ramp of the sample by sample processing are not used. The inputs matrix contains the channels samples with one row per channel (channels × vector size).
+        @param vectorsize   The vector size.
+        @param inputs       The inputs matrix.
+         */
+        void processBlock(const size_t vectorsize, const T* inputs) hoa_noexcept
+        {
+            if(!vectorsize)
+            {
+                return;
+            }
+            const size_t size = Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves();
+            const T peak_factor = m_peak_release > 0. ? T(exp(-T(vectorsize) / (m_peak_release * m_sample_rate))) : T(0.);
+            const T rms_factor  = m_rms_time > 0. ? T(exp(-T(vectorsize) / (m_rms_time * m_sample_rate))) : T(0.);
+            for(size_t i = 0; i < size; i++)
+            {
+                const T* input  = inputs + i * vectorsize;
+                const T peak    = Signal<T>::max(vectorsize, input);
+                const T power   = Signal<T>::energy(vectorsize, input) / T(vectorsize);
+                const T held    = m_channels_peaks[i] * peak_factor;
+                m_channels_peaks[i] = peak > held ? peak : held;
+                m_channels_power[i] = power + (m_channels_power[i] - power) * rms_factor;
+                if(m_true_peak_enabled)
+                {
+                    const T inter   = m_true_peak.process(i, vectorsize, input);
+                    const T current = inter > peak ? inter : peak;
+                    const T release = m_channels_true_peaks[i] * peak_factor;
+                    m_channels_true_peaks[i] = current > release ? current : release;
+                }
+                else
+                {
+                    m_channels_true_peaks[i] = m_channels_peaks[i];
+                }
+            }
+#if (__cplusplus > 199711L)
+            m_time += vectorsize;
+            publish();
+#endif
+        }
+
         //! This method update the meter.
         /** This method update the meter.
         @param input  The input samples.
@@ -242,25 +578,158 @@ namespace hoa
     private:
         size_t   m_ramp;
         size_t   m_vector_size;
-        T*      m_channels_peaks;
-        size_t*  m_over_leds;
+        Buffer<T> m_channels_peaks;
+        std::vector<size_t> m_over_leds;
+        Buffer<T>   m_channels_energy;
+        Buffer<T>   m_channels_power;
+        Buffer<T>   m_channels_true_peaks;
+        size_t      m_count;
+        T           m_sample_rate;
+        T           m_peak_release;
+        T           m_rms_time;
+        bool        m_true_peak_enabled;
+        TruePeak<T> m_true_peak;
+#if (__cplusplus > 199711L)
+        size_t      m_time;
+        Snapshot<T> m_snapshot;
+
+        inline void publish() hoa_noexcept
+        {
+            const size_t size = Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves();
+            T* values = m_snapshot.write();
+            for(size_t i = 0; i < size; i++)
+            {
+                values[i]               = m_channels_peaks[i];
+                values[i + size]        = sqrt(m_channels_power[i]);
+                values[i + size * 2]    = m_channels_peaks[i] >= 1. ? T(1.) : T(0.);
+                values[i + size * 3]    = m_channels_true_peaks[i];
+            }
+            m_snapshot.publish(m_time);
+        }
+#endif
+
+        static inline T getDecibels(const T value) hoa_noexcept
+        {
+            if(value > 0.)
+            {
+                return 20. * log10(value);
+            }
+            else
+            {
+                return -90.;
+            }
+        }
+
+        std::vector<Path> m_top;
+        std::vector<Path> m_bottom;
+        std::vector<Path> m_cells;
+        std::vector<T>    m_layout;
+        T                 m_rotation[3];
+        bool              m_cached;
+
+        //! Computes the unrotated cells of the channels.
+        /** The cells are only computed when the layout changes. If the channels surround the center of the sphere, the cells don't depend on the rotation and they are cached, the channels whose cells changed are marked.
+         */
+        void computeCells(std::vector<bool>& changed)
+        {
+            const size_t size = Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves();
+            bool moved = !m_cached;
+            for(size_t i = 0; i < size; i++)
+            {
+                moved = moved || m_layout[i * 3] != Processor<Hoa3d, T>::Planewaves::getPlanewaveAbscissa(i, false)
+                || m_layout[i * 3 + 1] != Processor<Hoa3d, T>::Planewaves::getPlanewaveOrdinate(i, false)
+                || m_layout[i * 3 + 2] != Processor<Hoa3d, T>::Planewaves::getPlanewaveHeight(i, false);
+            }
+            if(!moved)
+            {
+                return;
+            }
+
+            Voronoi<Hoa3d> voronoi;
+            for(size_t i = 0; i < size; i++)
+            {
+                m_layout[i * 3]     = Processor<Hoa3d, T>::Planewaves::getPlanewaveAbscissa(i, false);
+                m_layout[i * 3 + 1] = Processor<Hoa3d, T>::Planewaves::getPlanewaveOrdinate(i, false);
+                m_layout[i * 3 + 2] = Processor<Hoa3d, T>::Planewaves::getPlanewaveHeight(i, false);
+                voronoi.add(Point(m_layout[i * 3], m_layout[i * 3 + 1], m_layout[i * 3 + 2]));
+            }
+            const bool cached = voronoi.compute(false);
+            for(size_t i = 0; i < size && cached; i++)
+            {
+                Path const& bounds = voronoi.getBounds(i);
+                bool same = m_cached && bounds.size() == m_cells[i].size();
+                for(size_t j = 0; j < bounds.size() && same; j++)
+                {
+                    same = std::find(m_cells[i].begin(), m_cells[i].end(), bounds[j]) != m_cells[i].end();
+                }
+                if(!same)
+                {
+                    m_cells[i] = bounds;
+                    changed[i] = true;
+                }
+            }
+            m_cached = cached;
+        }
 
-        Path*   m_top;
-        Path*   m_bottom;
+        //! Computes the path of a channel from its cell.
+        /** The cell is rotated with the matrix of the rotation, then it is clipped to the top or to the bottom hemisphere.
+         */
+        void computePath(const size_t index, const T* matrix, const bool top)
+        {
+            const T sign = top ? 1. : -1.;
+            Point point(Processor<Hoa3d, T>::Planewaves::getPlanewaveAbscissa(index), Processor<Hoa3d, T>::Planewaves::getPlanewaveOrdinate(index), Processor<Hoa3d, T>::Planewaves::getPlanewaveHeight(index) * sign);
+            point.normalize();
+            Path const& cell = m_cells[index];
+            point.bounds.resize(cell.size());
+            for(size_t i = 0; i < cell.size(); i++)
+            {
+                point.bounds[i].x = matrix[0] * cell[i].x + matrix[1] * cell[i].y + matrix[2] * cell[i].z;
+                point.bounds[i].y = matrix[3] * cell[i].x + matrix[4] * cell[i].y + matrix[5] * cell[i].z;
+                point.bounds[i].z = (matrix[6] * cell[i].x + matrix[7] * cell[i].y + matrix[8] * cell[i].z) * sign;
+            }
+            point.filterBounds();
+            Path& path = top ? m_top[index] : m_bottom[index];
+            path = point.bounds;
+            for(size_t i = 0; i < path.size(); i++)
+            {
+                path[i].z *= sign;
+            }
+        }
 
     public:
         //! The meter constructor.
         /**	The meter constructor allocates and initialize the base classes.
          @param     numberOfPlanewaves      The number of channels.
          */
-        Meter(const size_t numberOfPlanewaves) hoa_noexcept : Processor<Hoa3d, T>::Planewaves(numberOfPlanewaves)
+        Meter(const size_t numberOfPlanewaves) hoa_noexcept :
+        Processor<Hoa3d, T>::Planewaves(numberOfPlanewaves),
+        m_true_peak(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves())
+#if (__cplusplus > 199711L)
+        , m_time(0)
+        , m_snapshot(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves() * 4)
+#endif
         {
             m_ramp                      = 0;
             m_vector_size               = 0;
-            m_channels_peaks            = Signal<T>::alloc(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
-            m_over_leds                 = new size_t[Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves()];
-            m_top                       = new Path[Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves()];
-            m_bottom                    = new Path[Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves()];
+            m_channels_peaks.resize(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
+            m_over_leds.resize(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
+            m_channels_energy.resize(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
+            m_channels_power.resize(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
+            m_channels_true_peaks.resize(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
+            Signal<T>::clear(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves(), m_channels_energy);
+            Signal<T>::clear(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves(), m_channels_power);
+            Signal<T>::clear(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves(), m_channels_true_peaks);
+            m_count             = 0;
+            m_sample_rate       = 44100.;
+            m_peak_release      = 0.;
+            m_rms_time          = 0.;
+            m_true_peak_enabled = false;
+            m_top.resize(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
+            m_bottom.resize(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
+            m_cells.resize(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
+            m_layout.resize(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves() * 3);
+            m_rotation[0] = m_rotation[1] = m_rotation[2] = 0.;
+            m_cached = false;
             for(size_t i = 0; i < Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves(); i++)
             {
                 m_channels_peaks[i] = 0;
@@ -268,22 +737,6 @@ namespace hoa
             }
         }
 
-        //! The destructor.
-        /** The destructor free the memory.
-         */
-        ~Meter()
-        {
-            Signal<T>::free(m_channels_peaks);
-            delete [] m_over_leds;
-            for(size_t i = 0; i < Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves(); i++)
-            {
-                m_top[i].clear();
-                m_bottom[i].clear();
-            }
-            delete [] m_top;
-            delete [] m_bottom;
-        }
-
         //! Set the vector size.
         /** Set the vector size.
         @param vectorSize    The new vector size.
@@ -292,6 +745,8 @@ namespace hoa
         {
             m_vector_size   = vectorSize;
             m_ramp          = 0;
+            Signal<T>::clear(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves(), m_channels_energy);
+            m_count = 0;
         }
 
         //! Get the vector size.
@@ -310,14 +765,27 @@ namespace hoa
          */
         inline T getPlanewaveEnergy(const size_t index) const hoa_noexcept
         {
-            if(m_channels_peaks[index] > 0.)
-            {
-                return 20. * log10(m_channels_peaks[index]);
-            }
-            else
-            {
-                return -90.;
-            }
+            return getDecibels(m_channels_peaks[index]);
+        }
+
+        //! Get the channel root mean square.
+        /** Get the channel root mean square in dB.
+        @param index    The index of the channel.
+        @return The channel root mean square.
+         */
+        inline T getPlanewaveRms(const size_t index) const hoa_noexcept
+        {
+            return getDecibels(sqrt(m_channels_power[index]));
+        }
+
+        //! Get the channel true peak.
+        /** Get the channel true peak in dB. The true peak is the peak if the true peak measure is disabled or if the meter is processed sample by sample.
+        @param index    The index of the channel.
+        @return The channel true peak.
+         */
+        inline T getPlanewaveTruePeak(const size_t index) const hoa_noexcept
+        {
+            return getDecibels(m_channels_true_peaks[index]);
         }
 
         //! Get the channel overLed state.
@@ -330,6 +798,17 @@ namespace hoa
             return m_over_leds[index];
         }
 
+#if (__cplusplus > 199711L)
+        //! Get the snapshot of the meter.
+        /** Get the snapshot that the process method publishes at the end of each period of the vector size and that the processBlock method publishes at the end of each block. A graphical interface or a monitoring thread should poll the snapshot instead of calling getPlanewaveEnergy, getPlanewaveOverLed and tick while the audio thread processes. A set of values contains the peaks of the channels, then the root mean squares of the channels, then the overload states of the channels (1 if the peak reached 0 dB, otherwise 0) and then the true peaks of the channels, its time is the number of samples processed.
+         @return The snapshot of the meter.
+         */
+        inline Snapshot<T>& getSnapshot() hoa_noexcept
+        {
+            return m_snapshot;
+        }
+#endif
+
         //! This method update the overLed state of the channels.
         /** This method update the overLed state of the channels.
         @param value    A no-NULL value to activate the overLed state of a channel
@@ -355,6 +834,28 @@ namespace hoa
          */
         inline void process(const T* inputs) hoa_noexcept
         {
+            if(m_ramp == m_vector_size)
+            {
+                const T count = m_count ? T(m_count) : T(1.);
+                for(size_t i = 0; i < Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves(); i++)
+                {
+                    m_channels_power[i]         = m_channels_energy[i] / count;
+                    m_channels_true_peaks[i]    = m_channels_peaks[i];
+                    m_channels_energy[i]        = 0;
+                }
+                m_count = 0;
+#if (__cplusplus > 199711L)
+                publish();
+#endif
+            }
+            for(size_t i = 0; i < Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves(); i++)
+            {
+                m_channels_energy[i] += inputs[i] * inputs[i];
+            }
+            m_count++;
+#if (__cplusplus > 199711L)
+            m_time++;
+#endif
             if(m_ramp++ == m_vector_size)
             {
                 m_ramp = 0;
@@ -376,6 +877,122 @@ namespace hoa
             }
         }
 
+        //! Set the sample rate.
+        /** Set the sample rate used to compute the ballistics of the block processing.
+        @param sampleRate   The sample rate.
+         */
+        inline void setSampleRate(const T sampleRate) hoa_noexcept
+        {
+            m_sample_rate = sampleRate > 0. ? sampleRate : T(44100.);
+        }
+
+        //! Get the sample rate.
+        /** Get the sample rate used to compute the ballistics of the block processing.
+        @return The sample rate.
+         */
+        inline T getSampleRate() const hoa_noexcept
+        {
+            return m_sample_rate;
+        }
+
+        //! Set the peak release.
+        /** Set the time in seconds that the peaks of the block processing take to decrease by a factor e (about 8.7 dB). A time of 0 means that the peaks are the peaks of the last block only.
+        @param time     The peak release.
+         */
+        inline void setPeakRelease(const T time) hoa_noexcept
+        {
+            m_peak_release = time > 0. ? time : T(0.);
+        }
+
+        //! Get the peak release.
+        /** Get the time in seconds that the peaks of the block processing take to decrease by a factor e.
+        @return The peak release.
+         */
+        inline T getPeakRelease() const hoa_noexcept
+        {
+            return m_peak_release;
+        }
+
+        //! Set the root mean square time.
+        /** Set the time constant in seconds of the integration of the root mean squares of the block processing. A time of 0 means that the root mean squares are the root mean squares of the last block only.
+        @param time     The root mean square time.
+         */
+        inline void setRmsTime(const T time) hoa_noexcept
+        {
+            m_rms_time = time > 0. ? time : T(0.);
+        }
+
+        //! Get the root mean square time.
+        /** Get the time constant in seconds of the integration of the root mean squares of the block processing.
+        @return The root mean square time.
+         */
+        inline T getRmsTime() const hoa_noexcept
+        {
+            return m_rms_time;
+        }
+
+        //! Enable or disable the true peak measure.
+        /** Enable or disable the measure of the inter-sample peaks with a 4 times oversampling in the block processing. The measure costs 36 multiplications per sample and per channel.
+        @param state    The state of the true peak measure.
+         */
+        inline void setTruePeak(const bool state) hoa_noexcept
+        {
+            if(state && !m_true_peak_enabled)
+            {
+                m_true_peak.clear();
+            }
+            m_true_peak_enabled = state;
+        }
+
+        //! Get the state of the true peak measure.
+        /** Get the state of the measure of the inter-sample peaks in the block processing.
+        @return The state of the true peak measure.
+         */
+        inline bool getTruePeak() const hoa_noexcept
+        {
+            return m_true_peak_enabled;
+        }
+
+        //! This method update the meter with a block of samples.
+        /** This method computes the peaks, the root mean squares and, if enabled, the true peaks of the channels for a block of samples and smoothes them with the peak release and the root mean square time. It should be preferred to the sample by sample processing, the vector size and the ramp of the sample by sample processing are not used. The inputs matrix contains the channels samples with one row per channel (channels × vector size).
+        @param vectorsize   The vector size.
+        @param inputs       The inputs matrix.
+         */
+        void processBlock(const size_t vectorsize, const T* inputs) hoa_noexcept
+        {
+            if(!vectorsize)
+            {
+                return;
+            }
+            const size_t size = Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves();
+            const T peak_factor = m_peak_release > 0. ? T(exp(-T(vectorsize) / (m_peak_release * m_sample_rate))) : T(0.);
+            const T rms_factor  = m_rms_time > 0. ? T(exp(-T(vectorsize) / (m_rms_time * m_sample_rate))) : T(0.);
+            for(size_t i = 0; i < size; i++)
+            {
+                const T* input  = inputs + i * vectorsize;
+                const T peak    = Signal<T>::max(vectorsize, input);
+                const T power   = Signal<T>::energy(vectorsize, input) / T(vectorsize);
+                const T held    = m_channels_peaks[i] * peak_factor;
+                m_channels_peaks[i] = peak > held ? peak : held;
+                m_channels_power[i] = power + (m_channels_power[i] - power) * rms_factor;
+                if(m_true_peak_enabled)
+                {
+                    const T inter   = m_true_peak.process(i, vectorsize, input);
+                    const T current = inter > peak ? inter : peak;
+                    const T release = m_channels_true_peaks[i] * peak_factor;
+                    m_channels_true_peaks[i] = current > release ? current : release;
+                }
+                else
+                {
+                    m_channels_true_peaks[i] = m_channels_peaks[i];
+                }
+            }
+#if (__cplusplus > 199711L)
+            m_time += vectorsize;
+            publish();
+#endif
+        }
+
         //! This method update the meter.
         /** This method update the meter.
         @param input  The input samples.
@@ -387,10 +1004,37 @@ namespace hoa
         }
 
         //! This method establish a model of a hoa meter.
-        /** This method establish a model of a hoa meter.
+        /** This method establish a model of a hoa meter. If the channels surround the center of the sphere, the Voronoi cells of the unrotated channels are cached. The cells are then only computed again when a channel moves and only the paths of the channels whose cells changed are updated, a rotation only rotates and clips the cached cells.
          */
         void computeRendering()
         {
+            const size_t size = Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves();
+            std::vector<bool> changed(size, false);
+            computeCells(changed);
+            if(m_cached)
+            {
+                const T rx = Processor<Hoa3d, T>::Planewaves::getPlanewavesRotationX();
+                const T ry = Processor<Hoa3d, T>::Planewaves::getPlanewavesRotationY();
+                const T rz = Processor<Hoa3d, T>::Planewaves::getPlanewavesRotationZ();
+                const bool rotated = rx != m_rotation[0] || ry != m_rotation[1] || rz != m_rotation[2];
+                m_rotation[0] = rx; m_rotation[1] = ry; m_rotation[2] = rz;
+
+                // The rotation of the planewaves around x, then z, then y
+                const T cx = cos(rx), sx = sin(rx), cy = cos(ry), sy = sin(ry), cz = cos(rz), sz = sin(rz);
+                const T matrix[9] = {cz * cy, -sz * cx * cy - sx * sy, sz * sx * cy - cx * sy,
+                    sz, cz * cx, -cz * sx,
+                    cz * sy, -sz * cx * sy + sx * cy, sz * sx * sy + cx * cy};
+                for(size_t i = 0; i < size; i++)
+                {
+                    if(rotated || changed[i])
+                    {
+                        computePath(i, matrix, true);
+                        computePath(i, matrix, false);
+                    }
+                }
+                return;
+            }
+
             Voronoi<Hoa3d> voronoi;
 
             for(size_t i = 0; i < Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves(); i++)
@@ -207,16 +207,18 @@ namespace hoa
     template <typename T> class Optim<Hoa2d, T>::MaxRe : public  Optim<Hoa2d, T>
     {
     private:
-        static T* generate(const size_t order)
+        static Buffer<T> generate(const size_t order)
         {
-            T* vector = Signal<T>::alloc(order);
-            for(size_t i = 1; i <= order; i++)
+            const size_t nharmonics = Harmonic<Hoa2d, T>::getNumberOfHarmonics(order);
+            Buffer<T> vector(nharmonics);
+            for(size_t i = 0; i < nharmonics; i++)
             {
-                vector[i-1] = cos(T(i) *  T(HOA_PI) / (T)(2. * order + 2.));
+                const size_t degree = Harmonic<Hoa2d, T>::getDegree(i);
+                vector[i] = degree ? T(cos(T(degree) * T(HOA_PI) / (T)(2. * order + 2.))) : T(1.);
             }
             return vector;
         }
-        const T*  m_weights;
+        Buffer<T> m_weights;
     public:
 
         //! The optimization constructor.
@@ -229,12 +231,24 @@ namespace hoa
             ;
         }
 
-        //! The optimization destructor.
-        /**	The optimization destructor free the memory.
+        //! This method performs the optimization of a block of samples.
+        /**	You should use this method for in-place or not-in-place processing of a block of samples. The inputs matrix and the outputs matrix contain the harmonics samples with one row per harmonic (harmonics × vector size). When the inputs are silent, the outputs are only cleared.
+         @param     vectorsize  The vector size.
+         @param     inputs      The inputs matrix.
+         @param     outputs     The outputs matrix.
          */
-        ~MaxRe() hoa_noexcept
+        inline void processBlock(const size_t vectorsize, T const* inputs, T* outputs) hoa_noexcept
         {
-             Signal<T>::free(const_cast<T*>(m_weights));
+            const size_t nharmonics = Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics();
+            if(Signal<T>::isZero(nharmonics * vectorsize, inputs))
+            {
+                Signal<T>::clear(nharmonics * vectorsize, outputs);
+                return;
+            }
+            for(size_t i = 0; i < nharmonics; i++)
+            {
+                Signal<T>::scale(vectorsize, m_weights[i], inputs + i * vectorsize, outputs + i * vectorsize);
+            }
         }
 
         //! This method performs the max-re optimization.
@@ -244,33 +258,31 @@ namespace hoa
          */
         inline void process(T const* inputs, T* outputs) hoa_noexcept hoa_override
         {
-            const T* weights = m_weights;
-            *outputs    = *inputs;
-            *(++outputs)  = *(++inputs) * *weights;
-            *(++outputs)  = *(++inputs) * *weights;
-            for(size_t i = 2; i <= Processor<Hoa2d, T>::Harmonics::getDecompositionOrder(); i++)
+            if(Signal<T>::isZero(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics(), inputs))
             {
-                const T weight = *(++weights);
-                *(++outputs) = *(++inputs) * weight;
-                *(++outputs) = *(++inputs) * weight;
+                Signal<T>::clear(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics(), outputs);
+                return;
             }
+            Signal<T>::mul(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics(), inputs, m_weights, outputs);
         }
     };
 
     template <typename T> class Optim<Hoa2d, T>::InPhase : public  Optim<Hoa2d, T>
     {
     private:
-        static T* generate(const size_t order)
+        static Buffer<T> generate(const size_t order)
         {
-            T* vector = Signal<T>::alloc(order);
+            const size_t nharmonics = Harmonic<Hoa2d, T>::getNumberOfHarmonics(order);
+            Buffer<T> vector(nharmonics);
             const T facn = Math<T>::factorial(long(order));
-            for(size_t i = 1; i <= order; i++)
+            for(size_t i = 0; i < nharmonics; i++)
             {
-                vector[i-1] = facn / Math<T>::factorial(long(order - i)) * facn / Math<T>::factorial(long(order + i));
+                const size_t degree = Harmonic<Hoa2d, T>::getDegree(i);
+                vector[i] = degree ? T(facn / Math<T>::factorial(long(order - degree)) * facn / Math<T>::factorial(long(order + degree))) : T(1.);
             }
             return vector;
         }
-        const T*  m_weights;
+        Buffer<T> m_weights;
     public:
 
         //! The optimization constructor.
@@ -283,12 +295,24 @@ namespace hoa
             ;
         }
 
-        //! The optimization destructor.
-        /**	The optimization destructor free the memory.
+        //! This method performs the optimization of a block of samples.
+        /**	You should use this method for in-place or not-in-place processing of a block of samples. The inputs matrix and the outputs matrix contain the harmonics samples with one row per harmonic (harmonics × vector size). When the inputs are silent, the outputs are only cleared.
+         @param     vectorsize  The vector size.
+         @param     inputs      The inputs matrix.
+         @param     outputs     The outputs matrix.
          */
-        ~InPhase() hoa_noexcept
+        inline void processBlock(const size_t vectorsize, T const* inputs, T* outputs) hoa_noexcept
         {
-             Signal<T>::free(const_cast<T*>(m_weights));
+            const size_t nharmonics = Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics();
+            if(Signal<T>::isZero(nharmonics * vectorsize, inputs))
+            {
+                Signal<T>::clear(nharmonics * vectorsize, outputs);
+                return;
+            }
+            for(size_t i = 0; i < nharmonics; i++)
+            {
+                Signal<T>::scale(vectorsize, m_weights[i], inputs + i * vectorsize, outputs + i * vectorsize);
+            }
         }
 
         //! This method performs the in-phase optimization.
@@ -298,16 +322,12 @@ namespace hoa
          */
         inline void process(T const* inputs, T* outputs) hoa_noexcept hoa_override
         {
-            const T* weights = m_weights;
-            *outputs    = *inputs;
-            *(++outputs)  = *(++inputs) * *weights;
-            *(++outputs)  = *(++inputs) * *weights;
-            for(size_t i = 2; i <= Processor<Hoa2d, T>::Harmonics::getDecompositionOrder(); i++)
+            if(Signal<T>::isZero(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics(), inputs))
             {
-                const T weight = *(++weights);
-                *(++outputs) = *(++inputs) * weight;
-                *(++outputs) = *(++inputs) * weight;
+                Signal<T>::clear(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics(), outputs);
+                return;
             }
+            Signal<T>::mul(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics(), inputs, m_weights, outputs);
         }
     };
 
@@ -400,16 +420,18 @@ namespace hoa
     template <typename T> class Optim<Hoa3d, T>::MaxRe : public Optim<Hoa3d, T>
     {
     private:
-        static T* generate(const size_t order)
+        static Buffer<T> generate(const size_t order)
         {
-            T* vector = Signal<T>::alloc(order);
-            for(size_t i = 1; i <= order; i++)
+            const size_t nharmonics = Harmonic<Hoa3d, T>::getNumberOfHarmonics(order);
+            Buffer<T> vector(nharmonics);
+            for(size_t i = 0; i < nharmonics; i++)
             {
-                vector[i-1] = cos(T(i) *  T(HOA_PI) / (T)(2. * order + 2.));
+                const size_t degree = Harmonic<Hoa3d, T>::getDegree(i);
+                vector[i] = degree ? T(cos(T(degree) * T(HOA_PI) / (T)(2. * order + 2.))) : T(1.);
             }
             return vector;
         }
-        const T*  m_weights;
+        Buffer<T> m_weights;
     public:
 
         //! The optimization constructor.
@@ -422,12 +444,24 @@ namespace hoa
             ;
         }
 
-        //! The optimization destructor.
-        /**	The optimization destructor free the memory.
+        //! This method performs the optimization of a block of samples.
+        /**	You should use this method for in-place or not-in-place processing of a block of samples. The inputs matrix and the outputs matrix contain the harmonics samples with one row per harmonic (harmonics × vector size). When the inputs are silent, the outputs are only cleared.
+         @param     vectorsize  The vector size.
+         @param     inputs      The inputs matrix.
+         @param     outputs     The outputs matrix.
          */
-        ~MaxRe() hoa_noexcept
+        inline void processBlock(const size_t vectorsize, T const* inputs, T* outputs) hoa_noexcept
         {
-             Signal<T>::free(const_cast<T*>(m_weights));
+            const size_t nharmonics = Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics();
+            if(Signal<T>::isZero(nharmonics * vectorsize, inputs))
+            {
+                Signal<T>::clear(nharmonics * vectorsize, outputs);
+                return;
+            }
+            for(size_t i = 0; i < nharmonics; i++)
+            {
+                Signal<T>::scale(vectorsize, m_weights[i], inputs + i * vectorsize, outputs + i * vectorsize);
+            }
         }
 
         //! This method performs the max-re optimization.
@@ -437,37 +471,32 @@ namespace hoa
          */
         inline void process(T const* inputs, T* outputs) hoa_noexcept hoa_override
         {
-            const T* weights = m_weights;
-            *outputs    = *inputs;
-            *(++outputs)  = *(++inputs) * *weights;
-            *(++outputs)  = *(++inputs) * *weights;
-            *(++outputs)  = *(++inputs) * *weights;
-            for(size_t i = 2; i <= Processor<Hoa3d, T>::Harmonics::getDecompositionOrder(); i++)
+            if(Signal<T>::isZero(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics(), inputs))
             {
-                const T weight = *(++weights);
-                for(size_t j = 0; j < 2 * i + 1; j++)
-                {
-                    *(++outputs) = *(++inputs) * weight;    // Hamonic [i, [-i...i]]
-                }
+                Signal<T>::clear(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics(), outputs);
+                return;
             }
+            Signal<T>::mul(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics(), inputs, m_weights, outputs);
         }
     };
 
     template <typename T> class Optim<Hoa3d, T>::InPhase : public Optim<Hoa3d, T>
     {
     private:
-        static T* generate(const size_t order)
+        static Buffer<T> generate(const size_t order)
         {
-            T* vector = Signal<T>::alloc(order);
+            const size_t nharmonics = Harmonic<Hoa3d, T>::getNumberOfHarmonics(order);
+            Buffer<T> vector(nharmonics);
             const T facn = Math<T>::factorial(long(order));
-            for(size_t i = 1; i <= order; i++)
+            for(size_t i = 0; i < nharmonics; i++)
             {
-                vector[i-1] = facn / Math<T>::factorial(long(order - i)) * facn / Math<T>::factorial(long(order + i));
+                const size_t degree = Harmonic<Hoa3d, T>::getDegree(i);
+                vector[i] = degree ? T(facn / Math<T>::factorial(long(order - degree)) * facn / Math<T>::factorial(long(order + degree))) : T(1.);
             }
             return vector;
         }
 
-        const T*  m_weights;
+        Buffer<T> m_weights;
     public:
 
         //! The optimization constructor.
@@ -480,12 +509,24 @@ namespace hoa
             ;
         }
 
-        //! The optimization destructor.
-        /**	The optimization destructor free the memory.
+        //! This method performs the optimization of a block of samples.
+        /**	You should use this method for in-place or not-in-place processing of a block of samples. The inputs matrix and the outputs matrix contain the harmonics samples with one row per harmonic (harmonics × vector size). When the inputs are silent, the outputs are only cleared.
+         @param     vectorsize  The vector size.
+         @param     inputs      The inputs matrix.
+         @param     outputs     The outputs matrix.
          */
-        ~InPhase() hoa_noexcept
+        inline void processBlock(const size_t vectorsize, T const* inputs, T* outputs) hoa_noexcept
         {
-            Signal<T>::free(const_cast<T*>(m_weights));
+            const size_t nharmonics = Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics();
+            if(Signal<T>::isZero(nharmonics * vectorsize, inputs))
+            {
+                Signal<T>::clear(nharmonics * vectorsize, outputs);
+                return;
+            }
+            for(size_t i = 0; i < nharmonics; i++)
+            {
+                Signal<T>::scale(vectorsize, m_weights[i], inputs + i * vectorsize, outputs + i * vectorsize);
+            }
         }
 
         //! This method performs the in-phase optimization.
@@ -495,19 +536,12 @@ namespace hoa
          */
         inline void process(T const* inputs, T* outputs) hoa_noexcept hoa_override
         {
-            const T* weights = m_weights;
-            *outputs    = *inputs;
-            *(++outputs)  = *(++inputs) * *weights;
-            *(++outputs)  = *(++inputs) * *weights;
-            *(++outputs)  = *(++inputs) * *weights;
-            for(size_t i = 2; i <= Processor<Hoa3d, T>::Harmonics::getDecompositionOrder(); i++)
+            if(Signal<T>::isZero(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics(), inputs))
             {
-                const T weight = *(++weights);
-                for(size_t j = 0; j < 2 * i + 1; j++)
-                {
-                    *(++outputs) = *(++inputs) * weight;    // Hamonic [i, [-i...i]]
-                }
+                Signal<T>::clear(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics(), outputs);
+                return;
             }
+            Signal<T>::mul(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics(), inputs, m_weights, outputs);
         }
     };
 
@@ -0,0 +1,175 @@
+/*
+// Copyright (c) 2012-2015 Pierre Guillot, Eliott Paris & Thomas Le Meur CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef DEF_HOA_POOL_LIGHT
+#define DEF_HOA_POOL_LIGHT
+
+#include "Defs.hpp"
+
+#if (__cplusplus > 199711L)
+#include <atomic>
+
+namespace hoa
+{
+    //! The pool class recycles initialized processors.
+    /** The pool should be used when processors are often created and destroyed, for example when a session that owns an encoder, a decoder or a binaural renderer starts and stops. The pool copies a prototype processor once for each object, so the matrices, the harmonics tables and the buffers are computed and allocated only when the pool is created. A released processor is reset by copying the prototype into it, this restores the parameters and clears the state without reallocating the buffers. Any number of threads can acquire and release the processors, none of the methods lock or wait.
+     */
+    template <class P> class Pool
+    {
+    private:
+        static const size_t m_cache_line = 64ul;
+
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            size_t              index;
+        };
+
+        const P                 m_prototype;
+        std::vector<P>          m_objects;
+        const size_t            m_mask;
+        std::vector<Cell>       m_cells;
+        char                    m_padding_begin[m_cache_line];
+        std::atomic<size_t>     m_acquire;
+        char                    m_padding_acquire[m_cache_line - sizeof(std::atomic<size_t>)];
+        std::atomic<size_t>     m_release;
+        char                    m_padding_release[m_cache_line - sizeof(std::atomic<size_t>)];
+
+        Pool(const Pool& other);
+        Pool& operator=(const Pool& other);
+
+        static inline size_t getCapacity(const size_t size) hoa_noexcept
+        {
+            size_t capacity = 1ul;
+            while(capacity < size)
+            {
+                capacity <<= 1;
+            }
+            return capacity;
+        }
+
+        inline void push(const size_t index) hoa_noexcept
+        {
+            size_t position = m_release.load(std::memory_order_relaxed);
+            for(;;)
+            {
+                Cell& cell = m_cells[position & m_mask];
+                const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                if(sequence == position)
+                {
+                    if(m_release.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        cell.index = index;
+                        cell.sequence.store(position + 1, std::memory_order_release);
+                        return;
+                    }
+                }
+                else
+                {
+                    position = m_release.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        inline bool pop(size_t& index) hoa_noexcept
+        {
+            size_t position = m_acquire.load(std::memory_order_relaxed);
+            for(;;)
+            {
+                Cell& cell = m_cells[position & m_mask];
+                const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                const std::ptrdiff_t difference = std::ptrdiff_t(sequence) - std::ptrdiff_t(position + 1);
+                if(difference == 0)
+                {
+                    if(m_acquire.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        index = cell.index;
+                        cell.sequence.store(position + m_mask + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if(difference < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    position = m_acquire.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+    public:
+
+        //! The pool constructor.
+        /**	The pool constructor copies the prototype for each object of the pool. The prototype should be fully initialized, for example a binaural decoder should have computed its rendering for the vector size of the host.
+         @param     prototype           The processor to copy.
+         @param     numberOfObjects     The number of processors of the pool.
+         */
+        Pool(const P& prototype, const size_t numberOfObjects) :
+        m_prototype(prototype),
+        m_objects(numberOfObjects, prototype),
+        m_mask(getCapacity(numberOfObjects) - 1),
+        m_cells(m_mask + 1),
+        m_acquire(0ul),
+        m_release(0ul)
+        {
+            for(size_t i = 0; i <= m_mask; i++)
+            {
+                m_cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            for(size_t i = 0; i < numberOfObjects; i++)
+            {
+                push(i);
+            }
+        }
+
+        //! Retrieve the number of processors.
+        /** Retrieve the number of processors owned by the pool, available or not.
+         @return The number of processors.
+         */
+        inline size_t getNumberOfObjects() const hoa_noexcept
+        {
+            return m_objects.size();
+        }
+
+        //! Retrieve the prototype.
+        /** Retrieve the processor that is copied to reset the released processors.
+         @return The prototype.
+         */
+        inline const P& getPrototype() const hoa_noexcept
+        {
+            return m_prototype;
+        }
+
+        //! Acquire a processor.
+        /** Retrieve an available processor in a constant time. The processor is in the same state as the prototype and belongs to the caller until it is released.
+         @return A processor or a null pointer if all the processors are in use.
+         */
+        inline P* acquire() hoa_noexcept
+        {
+            size_t index;
+            if(pop(index))
+            {
+                return &m_objects[index];
+            }
+            return hoa_nullptr;
+        }
+
+        //! Release a processor.
+        /** Reset a processor to the state of the prototype and give it back to the pool. The processor must have been acquired from this pool and must not be used after this call. The processor is reset with the copy assignment of P. For the processors of the library, the buffers already have the right sizes so the assignment only copies the values. If the assignment throws, the exception is propagated and the processor is not given back to the pool.
+         @param     object  The processor.
+         */
+        inline void release(P* object)
+        {
+            *object = m_prototype;
+            push(size_t(object - &m_objects[0]));
+        }
+    };
+}
+
+#endif
+#endif
@@ -40,9 +40,9 @@ namespace hoa
     {
     private:
 
-        const size_t                 m_order_of_decomposition;
-        const size_t                 m_number_of_harmonics;
-        std::vector< Harmonic<D, T> >    m_harmonics;
+        size_t                       m_order_of_decomposition;
+        size_t                       m_number_of_harmonics;
+        const HarmonicTable<D, T>*   m_table;
     public:
 
         //! The harmonics constructor.
@@ -51,20 +51,10 @@ namespace hoa
          */
         Harmonics(const size_t order) hoa_noexcept :
         m_order_of_decomposition(order),
-        m_number_of_harmonics(Harmonic<D, T>::getNumberOfHarmonics(order))
+        m_number_of_harmonics(Harmonic<D, T>::getNumberOfHarmonics(order)),
+        m_table(&HarmonicTable<D, T>::get(order))
         {
-            for(size_t i = 0; i < m_number_of_harmonics; i++)
-            {
-                m_harmonics.push_back(Harmonic<D, T>(i));
-            }
-        }
-
-        //! The harmonics destructor.
-        /** The harmonics destructor.
-         */
-        virtual ~Harmonics() hoa_noexcept
-        {
-            m_harmonics.clear();
+            ;
         }
 
         //! Retrieve the order of decomposition.
@@ -94,7 +84,7 @@ namespace hoa
          */
         inline size_t getHarmonicDegree(const size_t index) const hoa_noexcept
         {
-            return m_harmonics[index].getDegree();
+            return m_table->getDegree(index);
         }
 
         //! Retrieve the order of an harmonic.
@@ -106,7 +96,7 @@ namespace hoa
          */
         inline long getHarmonicOrder(const size_t index) const hoa_noexcept
         {
-            return m_harmonics[index].getOrder();
+            return m_table->getOrder(index);
         }
 
         //! Retrieve the index of an harmonic.
@@ -131,7 +121,7 @@ namespace hoa
          */
         inline std::string getHarmonicName(const size_t index) const hoa_noexcept
         {
-            return m_harmonics[index].getName();
+            return Harmonic<D, T>(index).getName();
         }
         
         //! Get the normalization of an harmonic.
@@ -141,7 +131,7 @@ namespace hoa
          */
         inline T getHarmonicNormalization(const size_t index) const hoa_noexcept
         {
-            return m_harmonics[index].getNormalization();
+            return m_table->getNormalization(index);
         }
         
         //! Get the semi-normalization of an harmonic.
@@ -151,7 +141,16 @@ namespace hoa
          */
         inline T getHarmonicSemiNormalization(const size_t index) const hoa_noexcept
         {
-            return m_harmonics[index].getSemiNormalization();
+            return m_table->getSemiNormalization(index);
+        }
+
+        //! Get the harmonic table.
+        /** The method returns the harmonic table shared by all the processors with the same order of decomposition.
+         @return    The harmonic table.
+         */
+        inline const HarmonicTable<D, T>& getHarmonicTable() const hoa_noexcept
+        {
+            return *m_table;
         }
 
         //! This method performs the processing.
@@ -165,18 +164,40 @@ namespace hoa
         }
     };
 
-
     //! The planewave processor.
     /** The planewave processor owns a set of planewaves.
      */
     template <Dimension D, typename T> class Processor<D, T>::Planewaves : virtual public Processor<D, T>
     {
     private:
-        const size_t                 m_number_of_planewaves;
+        size_t                       m_number_of_planewaves;
         std::vector<Planewave<D, T> >    m_planewaves;
         T                           m_rotation_z;
         T                           m_rotation_y;
         T                           m_rotation_x;
+        std::vector<T>              m_azimuths;
+        std::vector<T>              m_elevations;
+        std::vector<T>              m_abscissas;
+        std::vector<T>              m_ordinates;
+        std::vector<T>              m_heights;
+
+        inline void computePlanewave(const size_t index) hoa_noexcept
+        {
+            const Planewave<D, T>& planewave = m_planewaves[index];
+            m_azimuths[index]   = planewave.getAzimuth(m_rotation_x, m_rotation_y, m_rotation_z);
+            m_elevations[index] = planewave.getElevation(m_rotation_x, m_rotation_y, m_rotation_z);
+            m_abscissas[index]  = planewave.getAbscissa(m_rotation_x, m_rotation_y, m_rotation_z);
+            m_ordinates[index]  = planewave.getOrdinate(m_rotation_x, m_rotation_y, m_rotation_z);
+            m_heights[index]    = planewave.getHeight(m_rotation_x, m_rotation_y, m_rotation_z);
+        }
+
+        inline void computePlanewaves() hoa_noexcept
+        {
+            for(size_t i = 0; i < m_number_of_planewaves; i++)
+            {
+                computePlanewave(i);
+            }
+        }
 
     public:
 
@@ -286,14 +307,12 @@ namespace hoa
                 }
             }
 #endif
-        }
-
-        //! The planewaves destructor.
-        /** The planewaves destructor.
-         */
-        virtual ~Planewaves() hoa_noexcept
-        {
-            m_planewaves.clear();
+            m_azimuths.resize(m_number_of_planewaves);
+            m_elevations.resize(m_number_of_planewaves);
+            m_abscissas.resize(m_number_of_planewaves);
+            m_ordinates.resize(m_number_of_planewaves);
+            m_heights.resize(m_number_of_planewaves);
+            computePlanewaves();
         }
 
         //! Retrieve the order of decomposition.
@@ -316,6 +335,7 @@ namespace hoa
             m_rotation_x = Math<T>::wrap_twopi(x_axe);
             m_rotation_y = Math<T>::wrap_twopi(y_axe);
             m_rotation_z = Math<T>::wrap_twopi(z_axe);
+            computePlanewaves();
         }
 
         //! Get the offset of the planewaves.
@@ -364,6 +384,7 @@ namespace hoa
         inline void setPlanewaveAzimuth(const size_t index, const T azimuth) hoa_noexcept
         {
             m_planewaves[index].setAzimuth(Math<T>::wrap_twopi(azimuth));
+            computePlanewave(index);
         }
 
         //! Get the azimuth of a planewave.
@@ -375,7 +396,7 @@ namespace hoa
          */
         inline T getPlanewaveAzimuth(const size_t index, const bool rotation = true) const hoa_noexcept
         {
-            return m_planewaves[index].getAzimuth(rotation ? m_rotation_x : T(0.), rotation ? m_rotation_y : T(0.), rotation ? m_rotation_z : T(0.));
+            return rotation ? m_azimuths[index] : m_planewaves[index].getAzimuth(0., 0., 0.);
         }
 
         //! Set the elevation of a planewave.
@@ -387,6 +408,7 @@ namespace hoa
         inline void setPlanewaveElevation(const size_t index, const T azimuth) hoa_noexcept
         {
             m_planewaves[index].setElevation(Math<T>::wrap_pi(azimuth));
+            computePlanewave(index);
         }
 
         //! Get the elevation of a planewave.
@@ -398,7 +420,7 @@ namespace hoa
          */
         inline T getPlanewaveElevation(const size_t index, const bool rotation = true) const hoa_noexcept
         {
-            return m_planewaves[index].getElevation(rotation ? m_rotation_x : T(0.), rotation ? m_rotation_y : T(0.), rotation ? m_rotation_z : T(0.));
+            return rotation ? m_elevations[index] : m_planewaves[index].getElevation(0., 0., 0.);
         }
 
         //! Get the abscissa of a planewave.
@@ -409,7 +431,7 @@ namespace hoa
          */
         inline T getPlanewaveAbscissa(const size_t index, const bool rotation = true) const hoa_noexcept
         {
-            return m_planewaves[index].getAbscissa(rotation ? m_rotation_x : T(0.), rotation ? m_rotation_y : T(0.), rotation ? m_rotation_z : T(0.));
+            return rotation ? m_abscissas[index] : m_planewaves[index].getAbscissa(0., 0., 0.);
         }
 
         //! Get the ordinate of a planewave.
@@ -420,7 +442,7 @@ namespace hoa
          */
         inline T getPlanewaveOrdinate(const size_t index, const bool rotation = true) const hoa_noexcept
         {
-            return m_planewaves[index].getOrdinate(rotation ? m_rotation_x : T(0.), rotation ? m_rotation_y : T(0.), rotation ? m_rotation_z : T(0.));
+            return rotation ? m_ordinates[index] : m_planewaves[index].getOrdinate(0., 0., 0.);
         }
 
         //! Get the height of a planewave.
@@ -431,7 +453,52 @@ namespace hoa
          */
         inline T getPlanewaveHeight(const size_t index, const bool rotation = true) const hoa_noexcept
         {
-            return m_planewaves[index].getHeight(rotation ? m_rotation_x : T(0.), rotation ? m_rotation_y : T(0.), rotation ? m_rotation_z : T(0.));
+            return rotation ? m_heights[index] : m_planewaves[index].getHeight(0., 0., 0.);
+        }
+
+        //! Get the azimuths of the planewaves.
+        /** Get the azimuths of all the planewaves considering the rotation. The values are cached and only computed when the planewaves or the rotation change.
+         @return    The azimuths of the planewaves.
+         */
+        inline const T* getPlanewavesAzimuth() const hoa_noexcept
+        {
+            return &m_azimuths[0];
+        }
+
+        //! Get the elevations of the planewaves.
+        /** Get the elevations of all the planewaves considering the rotation. The values are cached and only computed when the planewaves or the rotation change.
+         @return    The elevations of the planewaves.
+         */
+        inline const T* getPlanewavesElevation() const hoa_noexcept
+        {
+            return &m_elevations[0];
+        }
+
+        //! Get the abscissas of the planewaves.
+        /** Get the abscissas of all the planewaves considering the rotation. The values are cached and only computed when the planewaves or the rotation change.
+         @return    The abscissas of the planewaves.
+         */
+        inline const T* getPlanewavesAbscissa() const hoa_noexcept
+        {
+            return &m_abscissas[0];
+        }
+
+        //! Get the ordinates of the planewaves.
+        /** Get the ordinates of all the planewaves considering the rotation. The values are cached and only computed when the planewaves or the rotation change.
+         @return    The ordinates of the planewaves.
+         */
+        inline const T* getPlanewavesOrdinate() const hoa_noexcept
+        {
+            return &m_ordinates[0];
+        }
+
+        //! Get the heights of the planewaves.
+        /** Get the heights of all the planewaves considering the rotation. The values are cached and only computed when the planewaves or the rotation change.
+         @return    The heights of the planewaves.
+         */
+        inline const T* getPlanewavesHeight() const hoa_noexcept
+        {
+            return &m_heights[0];
         }
 
         //! Get a name for a planewave.
@@ -9,6 +9,7 @@
 
 #include "Encoder.hpp"
 #include "Planewaves.hpp"
+#include "Fft.hpp"
 
 namespace hoa
 {
@@ -21,7 +22,8 @@ namespace hoa
     template <typename T> class Projector<Hoa2d, T> : public Encoder<Hoa2d, T>::Basic, public Processor<Hoa2d, T>::Planewaves
     {
     private:
-        T*  m_matrix;
+        Buffer<T> m_matrix;
+        FftProjection<T> m_fft;
     public:
 
         //! The regular constructor.
@@ -33,7 +35,7 @@ namespace hoa
         Encoder<Hoa2d, T>::Basic(order),
         Processor<Hoa2d, T>::Planewaves(numberOfPlanewaves)
         {
-            m_matrix = Signal<T>::alloc(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves() * Encoder<Hoa2d, T>::getNumberOfHarmonics());
+            m_matrix.resize(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves() * Encoder<Hoa2d, T>::getNumberOfHarmonics());
             const T factor = 1. / (T)(Encoder<Hoa2d, T>::getDecompositionOrder() + 1.);
             for(size_t i = 0; i < Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(); i++)
             {
@@ -41,14 +43,7 @@ namespace hoa
                 Encoder<Hoa2d, T>::Basic::process(&factor, m_matrix + i * Encoder<Hoa2d, T>::getNumberOfHarmonics());
                 m_matrix[i * Encoder<Hoa2d, T>::getNumberOfHarmonics()] = factor * 0.5;
             }
-        }
-
-        //! The Rotate destructor.
-        /**	The Rotate destructor free the memory.
-         */
-        ~Projector()
-        {
-            Signal<T>::free(m_matrix);
+            m_fft.compute(Encoder<Hoa2d, T>::getDecompositionOrder(), Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(), m_matrix);
         }
 
         //! This method performs the decoding.
@@ -58,7 +53,39 @@ namespace hoa
          */
         inline void process(const T* inputs, T* outputs) hoa_noexcept hoa_override
         {
-            Signal<T>::mul(Encoder<Hoa2d, T>::getNumberOfHarmonics(), Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(), inputs, m_matrix, outputs);
+            if(m_fft.isEnabled())
+            {
+                m_fft.process(inputs, outputs);
+            }
+            else
+            {
+                Signal<T>::mul(Encoder<Hoa2d, T>::getNumberOfHarmonics(), Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(), inputs, m_matrix, outputs);
+            }
+        }
+
+        //! This method performs the projection of a block of samples.
+        /**	You should use this method for not-in-place processing. The inputs matrix contains the harmonics samples with one row per harmonic (harmonics × vector size) and the outputs matrix contains the channels samples with one row per channel (channels × vector size).
+         @param     vectorsize  The vector size.
+         @param     inputs      The input matrix that contains the samples of the harmonics.
+         @param     outputs     The output matrix that contains samples destinated to channels.
+         */
+        inline void processBlock(const size_t vectorsize, const T* inputs, T* outputs) hoa_noexcept
+        {
+            processBlock(vectorsize, inputs, outputs, 0ul, Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
+        }
+
+        //! This method performs the projection of a block of samples for a range of channels.
+        /**	You should use this method to share the projection of a large number of channels between several threads. Each call only writes the rows of the outputs matrix that belong to the range of channels. With C++11, the workers class shares the ranges of a block between a pool of threads.
+         @param     vectorsize  The vector size.
+         @param     inputs      The input matrix that contains the samples of the harmonics.
+         @param     outputs     The output matrix that contains samples destinated to channels.
+         @param     first       The index of the first channel of the range.
+         @param     count       The number of channels of the range.
+         */
+        inline void processBlock(const size_t vectorsize, const T* inputs, T* outputs, const size_t first, const size_t count) hoa_noexcept
+        {
+            const size_t nharmonics = Encoder<Hoa2d, T>::getNumberOfHarmonics();
+            Signal<T>::mul(count, vectorsize, nharmonics, m_matrix + first * nharmonics, inputs, outputs + first * vectorsize);
         }
     };
 #endif
@@ -28,7 +28,7 @@ namespace hoa
     template <typename T> class Recomposer<Hoa2d, T, Fixe> : public Encoder<Hoa2d, T>::Basic, public Processor<Hoa2d, T>::Planewaves
     {
     private:
-        T* m_matrix;
+        Buffer<T> m_matrix;
 
     public:
         //! The recomposer constructor.
@@ -42,7 +42,7 @@ namespace hoa
         {
             const T factor = 1.;
             T* vector   = Signal<T>::alloc(Encoder<Hoa2d, T>::getNumberOfHarmonics());
-            m_matrix    = Signal<T>::alloc(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves() * Encoder<Hoa2d, T>::getNumberOfHarmonics());
+            m_matrix.resize(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves() * Encoder<Hoa2d, T>::getNumberOfHarmonics());
             for(size_t i = 0; i < Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(); i++)
             {
                 Encoder<Hoa2d, T>::Basic::setAzimuth(Processor<Hoa2d, T>::Planewaves::getPlanewaveAzimuth(i));
@@ -55,14 +55,6 @@ namespace hoa
             Signal<T>::free(vector);
         }
 
-        //! The destructor.
-        /** The destructor free the memory.
-         */
-        ~Recomposer()
-        {
-            Signal<T>::free(m_matrix);
-        }
-
         //! This method performs the recomposition.
         /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array contains the planewaves samples and the minimum size must be the number of planewaves and the outputs array contains the harmonic samples and the minimum size must be the number of harmonics.
          @param     inputs  The input array that contains the samples of the harmonics.
@@ -77,7 +69,7 @@ namespace hoa
     template <typename T> class Recomposer<Hoa2d, T, Fisheye> : public Processor<Hoa2d, T>::Harmonics, public Processor<Hoa2d, T>::Planewaves
     {
     private:
-        std::vector< typename Encoder<Hoa2d, T>::Basic*>m_encoders;
+        std::vector< typename Encoder<Hoa2d, T>::Basic > m_encoders;
     public:
         //! The decoder constructor.
         /**	The decoder constructor allocates and initialize the base classes.
@@ -86,24 +78,10 @@ namespace hoa
          */
         Recomposer(size_t order, size_t numberOfPlanewaves) hoa_noexcept :
         Processor<Hoa2d, T>::Harmonics(order),
-        Processor<Hoa2d, T>::Planewaves(numberOfPlanewaves)
+        Processor<Hoa2d, T>::Planewaves(numberOfPlanewaves),
+        m_encoders(numberOfPlanewaves, typename Encoder<Hoa2d, T>::Basic(order))
         {
-            for(size_t i = 0; i < Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(); i++)
-            {
-                m_encoders.push_back(new typename Encoder<Hoa2d, T>::Basic(order));
-            }
-        }
-
-        //! The destructor.
-        /** The destructor free the memory.
-         */
-        ~Recomposer()
-        {
-            for(size_t i = 0; i < Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(); i++)
-            {
-                delete m_encoders[i];
-            }
-            m_encoders.clear();
+            ;
         }
 
         //! Set the fishEye value.
@@ -124,7 +102,7 @@ namespace hoa
                 {
                     azimuth = HOA_2PI - ((HOA_2PI - azimuth) * factor);
                 }
-                m_encoders[i]->setAzimuth(azimuth);
+                m_encoders[i].setAzimuth(azimuth);
             }
         }
 
@@ -135,10 +113,10 @@ namespace hoa
          */
         inline void process(const T* inputs, T* outputs) hoa_noexcept hoa_override
         {
-            m_encoders[0]->process(inputs, outputs);
+            m_encoders[0].process(inputs, outputs);
             for(size_t i = 1; i < Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(); i++)
             {
-                m_encoders[i]->processAdd(++inputs, outputs);
+                m_encoders[i].processAdd(++inputs, outputs);
             }
         }
     };
@@ -146,7 +124,7 @@ namespace hoa
     template <typename T> class Recomposer<Hoa2d, T, Free> : public Processor<Hoa2d, T>::Harmonics, public Processor<Hoa2d, T>::Planewaves
     {
     private:
-        std::vector< typename Encoder<Hoa2d, T>::DC* >  m_encoders;
+        std::vector< typename Encoder<Hoa2d, T>::DC >   m_encoders;
     public:
         //! The decoder constructor.
         /**	The decoder constructor allocates and initialize the base classes.
@@ -155,25 +133,13 @@ namespace hoa
          */
         Recomposer(size_t order, size_t numberOfPlanewaves) hoa_noexcept :
         Processor<Hoa2d, T>::Harmonics(order),
-        Processor<Hoa2d, T>::Planewaves(numberOfPlanewaves)
-        {
-            for(size_t i = 0; i < Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(); i++)
-            {
-                m_encoders.push_back(new typename Encoder<Hoa2d, T>::DC(order));
-                m_encoders[i]->setAzimuth(i * (HOA_2PI / numberOfPlanewaves));
-            }
-        }
-
-        //! The destructor.
-        /** The destructor free the memory.
-         */
-        ~Recomposer()
+        Processor<Hoa2d, T>::Planewaves(numberOfPlanewaves),
+        m_encoders(numberOfPlanewaves, typename Encoder<Hoa2d, T>::DC(order))
         {
             for(size_t i = 0; i < Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(); i++)
             {
-                delete m_encoders[i];
+                m_encoders[i].setAzimuth(i * (HOA_2PI / numberOfPlanewaves));
             }
-            m_encoders.clear();
         }
 
         //! Set the azimuth.
@@ -182,7 +148,7 @@ namespace hoa
          */
         inline void setAzimuth(const size_t index, const T azim) hoa_noexcept
         {
-            m_encoders[index]->setAzimuth(azim);
+            m_encoders[index].setAzimuth(azim);
         }
 
         //! Set the widening value.
@@ -191,7 +157,7 @@ namespace hoa
          */
         inline void setWidening(const size_t index, const T radius) hoa_noexcept
         {
-            m_encoders[index]->setRadius(Math<T>::clip(radius, (T)0, (T)1));
+            m_encoders[index].setRadius(Math<T>::clip(radius, (T)0, (T)1));
         }
 
         //! Get the azimuth.
@@ -201,7 +167,7 @@ namespace hoa
          */
         inline T getAzimuth(const size_t index) const hoa_noexcept
         {
-            return m_encoders[index]->getAzimuth();
+            return m_encoders[index].getAzimuth();
         }
 
         //! Get the widening value.
@@ -211,7 +177,7 @@ namespace hoa
          */
         inline T getWidening(const size_t index) const hoa_noexcept
         {
-            return m_encoders[index]->getRadius();
+            return m_encoders[index].getRadius();
         }
 
         //! This method performs the recomposition.
@@ -221,10 +187,10 @@ namespace hoa
          */
         inline void process(const T* inputs, T* outputs) hoa_noexcept hoa_override
         {
-            m_encoders[0]->process(inputs, outputs);
+            m_encoders[0].process(inputs, outputs);
             for(size_t i = 1; i < Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(); i++)
             {
-                m_encoders[i]->processAdd(++inputs, outputs);
+                m_encoders[i].processAdd(++inputs, outputs);
             }
         }
     };
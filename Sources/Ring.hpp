@@ -0,0 +1,215 @@
+/*
+// Copyright (c) 2012-2015 Pierre Guillot, Eliott Paris & Thomas Le Meur CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef DEF_HOA_RING_LIGHT
+#define DEF_HOA_RING_LIGHT
+
+#include "Signal.hpp"
+
+#if (__cplusplus > 199711L)
+#include <atomic>
+
+namespace hoa
+{
+    //! The ring class passes blocks of multichannel signals from one thread to another.
+    /** The ring should be used to pipeline a processing chain on several threads or to pass the blocks between the audio input/output thread and the processing thread. One thread (the producer) pushes planar blocks of samples, for example the harmonics of an encoder, and another thread (the consumer) pops them, for example to decode them. There must be only one producer and only one consumer and none of the methods lock or wait. The blocks can be copied with push and pop or written and read in place with reserve/commit and acquire/release. When the ring is delayed, it starts with one block of silence so the consumer can always process the block pushed during the previous period while the producer computes the current one, the ring then adds exactly one block of latency.
+     */
+    template <typename T> class Ring
+    {
+    private:
+        static const size_t m_cache_line = 64ul;
+
+        const size_t        m_number_of_channels;
+        const size_t        m_vector_size;
+        const size_t        m_number_of_slots;
+        const size_t        m_slot_size;
+        const size_t        m_delay;
+        Buffer<T>           m_buffer;
+        std::vector<T*>     m_writers;
+        std::vector<const T*> m_readers;
+        char                m_padding_begin[m_cache_line];
+        std::atomic<size_t> m_head;
+        char                m_padding_head[m_cache_line - sizeof(std::atomic<size_t>)];
+        std::atomic<size_t> m_tail;
+        char                m_padding_tail[m_cache_line - sizeof(std::atomic<size_t>)];
+
+        Ring(const Ring& other);
+        Ring& operator=(const Ring& other);
+
+        static inline size_t getSlotSize(const size_t size) hoa_noexcept
+        {
+            const size_t line = m_cache_line / sizeof(T);
+            return ((size + line - 1) / line) * line;
+        }
+
+    public:
+
+        //! The ring constructor.
+        /**	The ring constructor allocates the slots of the ring. A delayed ring needs at least 2 slots, one for the block of silence and one for the producer, otherwise at least 1 slot, a smaller number of slots is raised to this minimum. Each slot starts on its own cache line so the producer and the consumer never write in the same line.
+         @param     numberOfChannels    The number of channels of a block.
+         @param     vectorsize          The vector size of a block.
+         @param     numberOfSlots       The maximum number of blocks in the ring.
+         @param     delayed             If the ring starts with one block of silence.
+         */
+        Ring(const size_t numberOfChannels, const size_t vectorsize, const size_t numberOfSlots = 2, const bool delayed = true) hoa_noexcept :
+        m_number_of_channels(numberOfChannels),
+        m_vector_size(vectorsize),
+        m_number_of_slots(std::max(numberOfSlots, delayed ? (size_t)2 : (size_t)1)),
+        m_slot_size(getSlotSize(numberOfChannels * vectorsize)),
+        m_delay(delayed ? 1ul : 0ul),
+        m_buffer(m_number_of_slots * m_slot_size + m_cache_line / sizeof(T)),
+        m_head(delayed ? 1ul : 0ul),
+        m_tail(0ul)
+        {
+            const size_t extra = m_cache_line / sizeof(T);
+            T* first = m_buffer;
+            while(size_t(first) % m_cache_line && first < m_buffer + extra)
+            {
+                first++;
+            }
+            for(size_t i = 0; i < m_number_of_slots; i++)
+            {
+                for(size_t j = 0; j < m_number_of_channels; j++)
+                {
+                    m_writers.push_back(first + i * m_slot_size + j * m_vector_size);
+                    m_readers.push_back(first + i * m_slot_size + j * m_vector_size);
+                }
+            }
+        }
+
+        //! Retrieve the number of channels.
+        /** Retrieve the number of channels of a block.
+         @return The number of channels.
+         */
+        inline size_t getNumberOfChannels() const hoa_noexcept
+        {
+            return m_number_of_channels;
+        }
+
+        //! Retrieve the vector size.
+        /** Retrieve the vector size of a block.
+         @return The vector size.
+         */
+        inline size_t getVectorSize() const hoa_noexcept
+        {
+            return m_vector_size;
+        }
+
+        //! Retrieve the number of slots.
+        /** Retrieve the maximum number of blocks in the ring.
+         @return The number of slots.
+         */
+        inline size_t getNumberOfSlots() const hoa_noexcept
+        {
+            return m_number_of_slots;
+        }
+
+        //! Retrieve the latency.
+        /** Retrieve the latency in samples added by the ring, the host should compensate it.
+         @return The latency in samples.
+         */
+        inline size_t getLatency() const hoa_noexcept
+        {
+            return m_delay * m_vector_size;
+        }
+
+        //! Retrieve the number of blocks available.
+        /** Retrieve the number of blocks that can be popped. The value is only an estimation if it is called from another thread than the consumer.
+         @return The number of blocks available.
+         */
+        inline size_t getNumberOfBlocks() const hoa_noexcept
+        {
+            return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+        }
+
+        //! Reserve the next block.
+        /** Retrieve the channels of the next free slot so the producer can write a block directly in the ring, for example with the outputs of a processBlock method. The channels are contiguous, the first pointer is also the beginning of a matrix (channels × vector size). The block is only visible to the consumer after a call to commit. This method must only be called by the producer.
+         @return The channels of the block or a null pointer if the ring is full.
+         */
+        inline T* const* reserve() hoa_noexcept
+        {
+            const size_t head = m_head.load(std::memory_order_relaxed);
+            if(head - m_tail.load(std::memory_order_acquire) >= m_number_of_slots)
+            {
+                return hoa_nullptr;
+            }
+            return &m_writers[(head % m_number_of_slots) * m_number_of_channels];
+        }
+
+        //! Commit the reserved block.
+        /** Publish the block previously reserved to the consumer. This method must only be called by the producer after a successful call to reserve.
+         */
+        inline void commit() hoa_noexcept
+        {
+            m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        //! Acquire the front block.
+        /** Retrieve the channels of the block at the front of the ring so the consumer can read it in place, for example as the inputs of a processBlock method. The block stays in the ring until a call to release. This method must only be called by the consumer.
+         @return The channels of the block or a null pointer if the ring is empty.
+         */
+        inline const T* const* acquire() hoa_noexcept
+        {
+            const size_t tail = m_tail.load(std::memory_order_relaxed);
+            if(m_head.load(std::memory_order_acquire) == tail)
+            {
+                return hoa_nullptr;
+            }
+            return &m_readers[(tail % m_number_of_slots) * m_number_of_channels];
+        }
+
+        //! Release the front block.
+        /** Remove the block previously acquired and give its slot back to the producer. This method must only be called by the consumer after a successful call to acquire.
+         */
+        inline void release() hoa_noexcept
+        {
+            m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        //! Push a block.
+        /** Copy a planar block at the end of the ring. This method must only be called by the producer.
+         @param     inputs  The planar block (channels × vector size).
+         @return    false if the ring is full, otherwise true.
+         */
+        inline bool push(const T* const* inputs) hoa_noexcept
+        {
+            T* const* slot = reserve();
+            if(!slot)
+            {
+                return false;
+            }
+            for(size_t i = 0; i < m_number_of_channels; i++)
+            {
+                Signal<T>::copy(m_vector_size, inputs[i], slot[i]);
+            }
+            commit();
+            return true;
+        }
+
+        //! Pop a block.
+        /** Copy the block at the front of the ring and remove it. This method must only be called by the consumer.
+         @param     outputs  The planar block (channels × vector size).
+         @return    false if the ring is empty, otherwise true.
+         */
+        inline bool pop(T** outputs) hoa_noexcept
+        {
+            const T* const* slot = acquire();
+            if(!slot)
+            {
+                return false;
+            }
+            for(size_t i = 0; i < m_number_of_channels; i++)
+            {
+                Signal<T>::copy(m_vector_size, slot[i], outputs[i]);
+            }
+            release();
+            return true;
+        }
+    };
+}
+
+#endif
+#endif
@@ -8,11 +8,18 @@
 #define DEF_HOA_ROTATE_LIGHT
 
 #include "Processor.hpp"
+#include <list>
+#include <map>
+#if (__cplusplus > 199711L)
+#include <mutex>
+#endif
 
 namespace hoa
 {
-    //! The rotate class rotates a sound field in the harmonics domain (2d available only).
-    /** The rotate should be used to rotate a sound field by weighting the harmonics depending on the rotation.
+    template <typename T> class RotationCache;
+
+    //! The rotate class rotates a sound field in the harmonics domain.
+    /** The rotate should be used to rotate a sound field by weighting the harmonics depending on the rotation. In 2d the rotation is only around the z axis, in 3d the rotation is defined by the yaw, the pitch and the roll.
      */
     template <Dimension D, typename T> class Rotate : public  Processor<D, T>::Harmonics
     {
@@ -41,6 +48,18 @@ namespace hoa
          */
         virtual T getYaw() const hoa_noexcept;
 
+        //! This method sets the angle of the rotation around the y axis, the pitch value (3d only).
+        /** The pitch is equivalent to a rotation around the axis from the right to the left, the pitch value is in radian and a positive value moves the front toward the top.
+         @param     pitch The pitch value.
+         */
+        virtual void setPitch(const T pitch) hoa_noexcept;
+
+        //! This method sets the angle of the rotation around the x axis, the roll value (3d only).
+        /** The roll is equivalent to a rotation around the axis from the back to the front, the roll value is in radian and a positive value moves the left toward the top.
+         @param     roll The roll value.
+         */
+        virtual void setRoll(const T roll) hoa_noexcept;
+
         //! This method performs the rotation.
         /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
          If \f$l = 0\f$
@@ -61,9 +80,63 @@ namespace hoa
     template <typename T> class Rotate<Hoa2d, T> : public Processor<Hoa2d, T>::Harmonics
     {
     private:
+        static const size_t m_chunk_size = 64ul;
+
         T   m_yaw;
         T   m_cosx;
         T   m_sinx;
+
+        //! Rotates a chunk of samples.
+        /** The sines and the cosines of each degree are computed for all the samples of the chunk, then each row is rotated. The loops over the samples have no dependency between the samples so they are left to the vectorization of the compiler.
+         */
+        inline void processChunk(const size_t vectorsize, const size_t offset, const size_t size, const T* cosx, const T* sinx, const T* inputs, T* outputs) const hoa_noexcept
+        {
+            T cos_l[m_chunk_size];
+            T sin_l[m_chunk_size];
+            for(size_t k = 0; k < size; k++)
+            {
+                cos_l[k] = cosx[k];
+                sin_l[k] = sinx[k];
+            }
+            for(size_t i = 1; i <= Processor<Hoa2d, T>::Harmonics::getDecompositionOrder(); i++)
+            {
+                if(i > 1)
+                {
+                    for(size_t k = 0; k < size; k++)
+                    {
+                        const T tcos_l = cos_l[k] * cosx[k] - sin_l[k] * sinx[k];
+                        sin_l[k] = cos_l[k] * sinx[k] + sin_l[k] * cosx[k];
+                        cos_l[k] = tcos_l;
+                    }
+                }
+                const T* in_sin = inputs + (2 * i - 1) * vectorsize + offset;
+                const T* in_cos = inputs + (2 * i) * vectorsize + offset;
+                T* out_sin      = outputs + (2 * i - 1) * vectorsize + offset;
+                T* out_cos      = outputs + (2 * i) * vectorsize + offset;
+                for(size_t k = 0; k < size; k++)
+                {
+                    const T sig_sin = in_sin[k];
+                    const T sig_cos = in_cos[k];
+                    out_sin[k] = sin_l[k] * sig_cos + cos_l[k] * sig_sin;
+                    out_cos[k] = cos_l[k] * sig_cos - sin_l[k] * sig_sin;
+                }
+            }
+        }
+
+        inline bool processSilence(const size_t vectorsize, const T* inputs, T* outputs) const hoa_noexcept
+        {
+            const size_t size = Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics() * vectorsize;
+            if(Signal<T>::isZero(size, inputs))
+            {
+                Signal<T>::clear(size, outputs);
+                return true;
+            }
+            if(inputs != outputs)
+            {
+                Signal<T>::copy(vectorsize, inputs, outputs);
+            }
+            return false;
+        }
     public:
 
         //! The rotate constructor.
@@ -72,7 +145,7 @@ namespace hoa
          */
         Rotate(const size_t order) hoa_noexcept : Processor<Hoa2d, T>::Harmonics(order)
         {
-            ;
+            setYaw(0.);
         }
 
         //! The Rotate destructor.
@@ -110,6 +183,11 @@ namespace hoa
          */
         inline void process(const T* inputs, T* outputs) hoa_noexcept hoa_override
         {
+            if(Signal<T>::isZero(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics(), inputs))
+            {
+                Signal<T>::clear(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics(), outputs);
+                return;
+            }
             T cos_x = m_cosx;
             T sin_x = m_sinx;
             T tcos_x = cos_x;
@@ -128,9 +206,568 @@ namespace hoa
                 (*outputs++) = cos_x * (*inputs++) - sin_x * sig;
             }
         }
+
+        //! This method performs the rotation of a block of samples with a smooth change of the yaw.
+        /**	You should use this method for in-place or not-in-place processing of a block of samples. The inputs matrix and the outputs matrix contain the harmonics samples with one row per harmonic (harmonics × vector size). The yaw moves linearly, by the shortest path, from the current yaw to the new yaw over the block and the new yaw becomes the current one. The sines and the cosines of the samples are computed with a complex recurrence that is restarted every 64 samples to avoid the drift.
+         @param     vectorsize  The vector size.
+         @param     inputs      The inputs matrix.
+         @param     outputs     The outputs matrix.
+         @param     yaw         The yaw at the end of the block.
+         */
+        inline void processBlock(const size_t vectorsize, const T* inputs, T* outputs, const T yaw) hoa_noexcept
+        {
+            const T start = m_yaw;
+            const T step  = Math<T>::wrap_pi(yaw - start) / T(vectorsize);
+            if(!processSilence(vectorsize, inputs, outputs))
+            {
+                const T cos_step = std::cos(step);
+                const T sin_step = std::sin(step);
+                T cosx[m_chunk_size];
+                T sinx[m_chunk_size];
+                for(size_t offset = 0; offset < vectorsize; offset += m_chunk_size)
+                {
+                    const size_t size = (vectorsize - offset < m_chunk_size) ? vectorsize - offset : m_chunk_size;
+                    T cos_x = std::cos(start + step * T(offset + 1));
+                    T sin_x = std::sin(start + step * T(offset + 1));
+                    for(size_t k = 0; k < size; k++)
+                    {
+                        cosx[k] = cos_x;
+                        sinx[k] = sin_x;
+                        const T tcos_x = cos_x * cos_step - sin_x * sin_step;
+                        sin_x  = cos_x * sin_step + sin_x * cos_step;
+                        cos_x  = tcos_x;
+                    }
+                    processChunk(vectorsize, offset, size, cosx, sinx, inputs, outputs);
+                }
+            }
+            setYaw(start + step * T(vectorsize));
+        }
+
+        //! This method performs the rotation of a block of samples with a yaw for each sample.
+        /**	You should use this method for in-place or not-in-place processing of a block of samples when the yaw follows an automation curve. The inputs matrix and the outputs matrix contain the harmonics samples with one row per harmonic (harmonics × vector size). The yaw of the last sample becomes the current yaw.
+         @param     vectorsize  The vector size.
+         @param     inputs      The inputs matrix.
+         @param     outputs     The outputs matrix.
+         @param     yaws        The yaw values of the samples.
+         */
+        inline void processBlockRamp(const size_t vectorsize, const T* inputs, T* outputs, const T* yaws) hoa_noexcept
+        {
+            if(!processSilence(vectorsize, inputs, outputs))
+            {
+                T cosx[m_chunk_size];
+                T sinx[m_chunk_size];
+                for(size_t offset = 0; offset < vectorsize; offset += m_chunk_size)
+                {
+                    const size_t size = (vectorsize - offset < m_chunk_size) ? vectorsize - offset : m_chunk_size;
+                    for(size_t k = 0; k < size; k++)
+                    {
+                        cosx[k] = std::cos(yaws[offset + k]);
+                        sinx[k] = std::sin(yaws[offset + k]);
+                    }
+                    processChunk(vectorsize, offset, size, cosx, sinx, inputs, outputs);
+                }
+            }
+            if(vectorsize)
+            {
+                setYaw(yaws[vectorsize - 1]);
+            }
+        }
+    };
+
+    template <typename T> class Rotate<Hoa3d, T> : public Processor<Hoa3d, T>::Harmonics
+    {
+    private:
+        T           m_yaw;
+        T           m_pitch;
+        T           m_roll;
+        Buffer<T>   m_matrix;
+        Buffer<T>   m_vector;
+
+        static inline size_t getOffset(const long degree) hoa_noexcept
+        {
+            return size_t(degree * (2 * degree - 1) * (2 * degree + 1) / 3);
+        }
+
+        static inline T getElement(const T* matrix, const long degree, const long row, const long column) hoa_noexcept
+        {
+            return matrix[(row + degree) * (2 * degree + 1) + (column + degree)];
+        }
+
+        static inline T getTerm(const T* first, const T* previous, const long i, const long degree, const long a, const long b) hoa_noexcept
+        {
+            const long p = degree - 1;
+            const T ri1  = getElement(first, 1, i, 1);
+            const T rim1 = getElement(first, 1, i, -1);
+            const T ri0  = getElement(first, 1, i, 0);
+            if(b == -degree)
+            {
+                return ri1 * getElement(previous, p, a, -p) + rim1 * getElement(previous, p, a, p);
+            }
+            else if(b == degree)
+            {
+                return ri1 * getElement(previous, p, a, p) - rim1 * getElement(previous, p, a, -p);
+            }
+            return ri0 * getElement(previous, p, a, b);
+        }
+
+        void computeRotation() hoa_noexcept
+        {
+            const T cy = std::cos(m_yaw),   sy = std::sin(m_yaw);
+            const T cp = std::cos(m_pitch), sp = std::sin(m_pitch);
+            const T cr = std::cos(m_roll),  sr = std::sin(m_roll);
+
+            // The rotation of the cartesian coordinates Rz(yaw) × Ry(pitch) × Rx(roll)
+            const T rxx = cy * cp, rxy = -cy * sp * sr - sy * cr, rxz = -cy * sp * cr + sy * sr;
+            const T ryx = sy * cp, ryy = -sy * sp * sr + cy * cr, ryz = -sy * sp * cr - cy * sr;
+            const T rzx = sp,      rzy = cp * sr,                 rzz = cp * cr;
+
+            T* matrix = m_matrix;
+            matrix[0] = 1.;
+
+            // The harmonics of degree 1 are ordered (y, z, x)
+            T* first = matrix + 1;
+            first[0] = ryy; first[1] = ryz; first[2] = ryx;
+            first[3] = rzy; first[4] = rzz; first[5] = rzx;
+            first[6] = rxy; first[7] = rxz; first[8] = rxx;
+
+            // Ivanic and Ruedenberg recurrence (with the corrections of 1998)
+            const long order = long(Processor<Hoa3d, T>::Harmonics::getDecompositionOrder());
+            for(long l = 2; l <= order; l++)
+            {
+                const T* previous = matrix + getOffset(l - 1);
+                T* current  = matrix + getOffset(l);
+                for(long m = -l; m <= l; m++)
+                {
+                    const long am = std::abs(m);
+                    for(long n = -l; n <= l; n++)
+                    {
+                        const T denom = (std::abs(n) == l) ? T((2 * l) * (2 * l - 1)) : T((l + n) * (l - n));
+                        const T d = (m == 0) ? T(1.) : T(0.);
+                        const T u = std::sqrt(T((l + m) * (l - m)) / denom);
+                        const T v = T(0.5) * std::sqrt((T(1.) + d) * T((l + am - 1) * (l + am)) / denom) * (T(1.) - T(2.) * d);
+                        const T w = T(-0.5) * std::sqrt(T((l - am - 1) * (l - am)) / denom) * (T(1.) - d);
+
+                        T value = 0.;
+                        if(u != T(0.))
+                        {
+                            value += u * getTerm(first, previous, 0, l, m, n);
+                        }
+                        if(v != T(0.))
+                        {
+                            if(m == 0)
+                            {
+                                value += v * (getTerm(first, previous, 1, l, 1, n) + getTerm(first, previous, -1, l, -1, n));
+                            }
+                            else if(m > 0)
+                            {
+                                const T d1 = (m == 1) ? T(1.) : T(0.);
+                                value += v * (getTerm(first, previous, 1, l, m - 1, n) * std::sqrt(T(1.) + d1) - getTerm(first, previous, -1, l, -m + 1, n) * (T(1.) - d1));
+                            }
+                            else
+                            {
+                                const T d1 = (m == -1) ? T(1.) : T(0.);
+                                value += v * (getTerm(first, previous, 1, l, m + 1, n) * (T(1.) - d1) + getTerm(first, previous, -1, l, -m - 1, n) * std::sqrt(T(1.) + d1));
+                            }
+                        }
+                        if(w != T(0.))
+                        {
+                            if(m > 0)
+                            {
+                                value += w * (getTerm(first, previous, 1, l, m + 1, n) + getTerm(first, previous, -1, l, -m - 1, n));
+                            }
+                            else
+                            {
+                                value += w * (getTerm(first, previous, 1, l, m - 1, n) - getTerm(first, previous, -1, l, -m + 1, n));
+                            }
+                        }
+                        current[(m + l) * (2 * l + 1) + (n + l)] = value;
+                    }
+                }
+            }
+
+            // The zonal harmonics of the encoders are not semi-normalized, the matrices are scaled to match them
+            const T factor = std::sqrt(T(4. * HOA_PI));
+            for(long l = 1; l <= order; l++)
+            {
+                T* current  = matrix + getOffset(l);
+                const long size = 2 * l + 1;
+                for(long i = 0; i < size; i++)
+                {
+                    current[l * size + i] *= factor;
+                    current[i * size + l] /= factor;
+                }
+            }
+        }
+
+    public:
+
+        //! The rotate constructor.
+        /**	The rotate constructor allocates and initialize the member values to computes spherical harmonics rotation depending on a order of decomposition. The order must be at least 1.
+         @param     order	The order.
+         */
+        Rotate(const size_t order) hoa_noexcept : Processor<Hoa3d, T>::Harmonics(order),
+        m_yaw(0.),
+        m_pitch(0.),
+        m_roll(0.),
+        m_matrix(getOffset(long(order) + 1)),
+        m_vector(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics())
+        {
+            computeRotation();
+        }
+
+        //! This method sets the angles of the rotation.
+        /** The method sets the yaw, the pitch and the roll and computes the rotation only once. The sound field is rotated by the roll first, then by the pitch and then by the yaw.
+         @param     yaw     The yaw value.
+         @param     pitch   The pitch value.
+         @param     roll    The roll value.
+         */
+        inline void setRotation(const T yaw, const T pitch, const T roll) hoa_noexcept
+        {
+            m_yaw   = yaw;
+            m_pitch = pitch;
+            m_roll  = roll;
+            computeRotation();
+        }
+
+        //! This method sets the angles of the rotation from a rotation cache.
+        /** The method copies the rotation of the quantized orientation from the cache, so the rotation is only computed if the cache doesn't have it yet. The angles become the ones of the quantized orientation. The cache must have the same order of decomposition. A head-tracked binaural rendering should use this method to rotate the sound field before the binaural decoder.
+         @param     yaw     The yaw value.
+         @param     pitch   The pitch value.
+         @param     roll    The roll value.
+         @param     cache   The rotation cache.
+         */
+        inline void setRotation(const T yaw, const T pitch, const T roll, RotationCache<T>& cache)
+        {
+            cache.get(yaw, pitch, roll, *this);
+        }
+
+        //! This method sets the angle of the rotation around the z axis, the yaw value.
+        /** The yaw is equivalent to a rotation around the z axis, the value is in radian and should be between 0 and 2π.
+         @param     yaw The yaw value.
+         */
+        inline void setYaw(const T yaw) hoa_noexcept
+        {
+            m_yaw = yaw;
+            computeRotation();
+        }
+
+        //! This method sets the angle of the rotation around the y axis, the pitch value.
+        /** The pitch is equivalent to a rotation around the axis from the right to the left, the value is in radian and a positive value moves the front toward the top.
+         @param     pitch The pitch value.
+         */
+        inline void setPitch(const T pitch) hoa_noexcept
+        {
+            m_pitch = pitch;
+            computeRotation();
+        }
+
+        //! This method sets the angle of the rotation around the x axis, the roll value.
+        /** The roll is equivalent to a rotation around the axis from the back to the front, the value is in radian and a positive value moves the left toward the top.
+         @param     roll The roll value.
+         */
+        inline void setRoll(const T roll) hoa_noexcept
+        {
+            m_roll = roll;
+            computeRotation();
+        }
+
+        //! Get the angle of the rotation around the z axis, the yaw value.
+        /** The method returns the angle of the rotation around the z axis, the yaw value, in radian between 0 and 2π.
+         @return     The yaw value.
+         */
+        inline T getYaw() const hoa_noexcept
+        {
+            return Math<T>::wrap_twopi(m_yaw);
+        }
+
+        //! Get the angle of the rotation around the y axis, the pitch value.
+        /** The method returns the angle of the rotation around the y axis, the pitch value, in radian between -π and π.
+         @return     The pitch value.
+         */
+        inline T getPitch() const hoa_noexcept
+        {
+            return Math<T>::wrap_pi(m_pitch);
+        }
+
+        //! Get the angle of the rotation around the x axis, the roll value.
+        /** The method returns the angle of the rotation around the x axis, the roll value, in radian between -π and π.
+         @return     The roll value.
+         */
+        inline T getRoll() const hoa_noexcept
+        {
+            return Math<T>::wrap_pi(m_roll);
+        }
+
+        //! Get the rotation matrix of a degree.
+        /** The method returns the rotation matrix of the harmonics of a degree, the matrix has \f$2l+1\f$ rows and \f$2l+1\f$ columns ordered by the orders from \f$-l\f$ to \f$l\f$.
+         @param     degree  The degree.
+         @return    The rotation matrix.
+         */
+        inline const T* getRotationMatrix(const size_t degree) const hoa_noexcept
+        {
+            return static_cast<const T*>(m_matrix) + getOffset(long(degree));
+        }
+
+        //! This method performs the rotation.
+        /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and outputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics. The harmonics of each degree are multiplied by the rotation matrix of the degree.
+         @param     inputs   The input array.
+         @param     outputs  The output array.
+         */
+        inline void process(const T* inputs, T* outputs) hoa_noexcept hoa_override
+        {
+            const size_t nharmonics = Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics();
+            if(Signal<T>::isZero(nharmonics, inputs))
+            {
+                Signal<T>::clear(nharmonics, outputs);
+                return;
+            }
+            Signal<T>::copy(nharmonics, inputs, m_vector);
+            outputs[0] = m_vector[0];
+            for(size_t l = 1; l <= Processor<Hoa3d, T>::Harmonics::getDecompositionOrder(); l++)
+            {
+                const size_t size = 2 * l + 1;
+                Signal<T>::mul(size, size, m_vector + l * l, getRotationMatrix(l), outputs + l * l);
+            }
+        }
+
+        //! This method performs the rotation of a block of samples.
+        /**	You should use this method for not-in-place processing. The inputs matrix and the outputs matrix contain the harmonics samples with one row per harmonic (harmonics × vector size). The harmonics of each degree are multiplied by the rotation matrix of the degree.
+         @param     vectorsize  The vector size.
+         @param     inputs      The inputs matrix.
+         @param     outputs     The outputs matrix.
+         */
+        inline void processBlock(const size_t vectorsize, const T* inputs, T* outputs) hoa_noexcept
+        {
+            const size_t nharmonics = Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics();
+            if(Signal<T>::isZero(nharmonics * vectorsize, inputs))
+            {
+                Signal<T>::clear(nharmonics * vectorsize, outputs);
+                return;
+            }
+            Signal<T>::copy(vectorsize, inputs, outputs);
+            for(size_t l = 1; l <= Processor<Hoa3d, T>::Harmonics::getDecompositionOrder(); l++)
+            {
+                const size_t size = 2 * l + 1;
+                Signal<T>::mul(size, vectorsize, size, getRotationMatrix(l), inputs + l * l * vectorsize, outputs + l * l * vectorsize);
+            }
+        }
     };
 
 #endif
+
+    //! The rotation cache class shares the rotations of close orientations.
+    /** The rotation cache should be used when the rotation matrices are often requested for similar orientations, for example with the head-trackers of several listeners. The orientations are converted to quaternions and quantized with an angular resolution, the rotations of the quantized orientations are computed once and kept until they are the least recently used ones and the cache is full. The methods are thread-safe with C++11 and later.
+     */
+    template <typename T> class RotationCache
+    {
+    private:
+        struct Key
+        {
+            long w, x, y, z;
+
+            inline bool operator<(const Key& other) const hoa_noexcept
+            {
+                if(w != other.w) return w < other.w;
+                if(x != other.x) return x < other.x;
+                if(y != other.y) return y < other.y;
+                return z < other.z;
+            }
+        };
+
+        struct Entry
+        {
+            Key                 key;
+            bool                valid;
+            Rotate<Hoa3d, T>    rotate;
+
+            Entry(const size_t order) : key(), valid(false), rotate(order) {}
+        };
+
+        typedef typename std::list<Entry>::iterator Iterator;
+
+        const size_t            m_order_of_decomposition;
+        const size_t            m_capacity;
+        const T                 m_resolution;
+        std::list<Entry>        m_entries;
+        std::map<Key, Iterator> m_keys;
+#if (__cplusplus > 199711L)
+        std::mutex              m_mutex;
+#endif
+
+        RotationCache(const RotationCache& other);
+        RotationCache& operator=(const RotationCache& other);
+
+        inline Key getKey(const T yaw, const T pitch, const T roll) const hoa_noexcept
+        {
+            // The quaternion of Rz(yaw) × Ry(pitch) × Rx(roll), the pitch moves the front toward the top
+            const T cy = std::cos(yaw * T(0.5)),   sy = std::sin(yaw * T(0.5));
+            const T cp = std::cos(pitch * T(0.5)), sp = -std::sin(pitch * T(0.5));
+            const T cr = std::cos(roll * T(0.5)),  sr = std::sin(roll * T(0.5));
+            T w = cr * cp * cy + sr * sp * sy;
+            T x = sr * cp * cy - cr * sp * sy;
+            T y = cr * sp * cy + sr * cp * sy;
+            T z = cr * cp * sy - sr * sp * cy;
+            if(w < T(0.))
+            {
+                w = -w; x = -x; y = -y; z = -z;
+            }
+            const T factor = T(2.) / m_resolution;
+            Key key;
+            key.w = long(std::floor(w * factor + T(0.5)));
+            key.x = long(std::floor(x * factor + T(0.5)));
+            key.y = long(std::floor(y * factor + T(0.5)));
+            key.z = long(std::floor(z * factor + T(0.5)));
+            return key;
+        }
+
+        inline void setRotation(const Key& key, Rotate<Hoa3d, T>& rotate) const hoa_noexcept
+        {
+            const T w = T(key.w), x = T(key.x), y = T(key.y), z = T(key.z);
+            const T norm = w * w + x * x + y * y + z * z;
+            if(norm == T(0.))
+            {
+                rotate.setRotation(0., 0., 0.);
+                return;
+            }
+            const T sinp = Math<T>::clip(T(2.) * (w * y - z * x) / norm, T(-1.), T(1.));
+            rotate.setRotation(std::atan2(T(2.) * (w * z + x * y), norm - T(2.) * (y * y + z * z)),
+                               -std::asin(sinp),
+                               std::atan2(T(2.) * (w * x + y * z), norm - T(2.) * (x * x + y * y)));
+        }
+
+    public:
+
+        //! The rotation cache constructor.
+        /**	The rotation cache constructor allocates the rotations of the cache. The order must be at least 1 and the capacity at least 1.
+         @param     order       The order of decomposition.
+         @param     capacity    The maximum number of rotations kept by the cache.
+         @param     resolution  The angular resolution in radian.
+         */
+        RotationCache(const size_t order, const size_t capacity, const T resolution = T(HOA_PI / 180.)) :
+        m_order_of_decomposition(order),
+        m_capacity(std::max(capacity, (size_t)1)),
+        m_resolution(resolution),
+        m_entries(m_capacity, Entry(order))
+        {
+            ;
+        }
+
+        //! Retrieve the order of decomposition.
+        /** Retrieve the order of decomposition of the rotations.
+         @return The order.
+         */
+        inline size_t getDecompositionOrder() const hoa_noexcept
+        {
+            return m_order_of_decomposition;
+        }
+
+        //! Retrieve the capacity.
+        /** Retrieve the maximum number of rotations kept by the cache.
+         @return The capacity.
+         */
+        inline size_t getCapacity() const hoa_noexcept
+        {
+            return m_capacity;
+        }
+
+        //! Retrieve the resolution.
+        /** Retrieve the angular resolution of the cache in radian.
+         @return The resolution.
+         */
+        inline T getResolution() const hoa_noexcept
+        {
+            return m_resolution;
+        }
+
+        //! Retrieve the number of rotations.
+        /** Retrieve the number of rotations currently kept by the cache.
+         @return The number of rotations.
+         */
+        inline size_t getNumberOfRotations()
+        {
+#if (__cplusplus > 199711L)
+            std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+            return m_keys.size();
+        }
+
+        //! Check if a rotation is in the cache.
+        /** Check if the rotation of the quantized orientation is kept by the cache, the order of the least recently used rotations is not changed.
+         @param     yaw     The yaw value.
+         @param     pitch   The pitch value.
+         @param     roll    The roll value.
+         @return    true if the rotation is in the cache, otherwise false.
+         */
+        bool contains(const T yaw, const T pitch, const T roll)
+        {
+            const Key key = getKey(yaw, pitch, roll);
+#if (__cplusplus > 199711L)
+            std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+            return m_keys.find(key) != m_keys.end();
+        }
+
+        //! Get a rotation.
+        /** Copy the rotation of the quantized orientation in a rotate, the rotation is computed only if it is not in the cache and the lock is not held during the computation, so the other threads are only blocked by the copies. The rotate must have the same order of decomposition as the cache and its angles become the ones of the quantized orientation.
+         @param     yaw     The yaw value.
+         @param     pitch   The pitch value.
+         @param     roll    The roll value.
+         @param     rotate  The rotate that receives the rotation.
+         */
+        void get(const T yaw, const T pitch, const T roll, Rotate<Hoa3d, T>& rotate)
+        {
+            const Key key = getKey(yaw, pitch, roll);
+            {
+#if (__cplusplus > 199711L)
+                std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+                typename std::map<Key, Iterator>::iterator it = m_keys.find(key);
+                if(it != m_keys.end())
+                {
+                    m_entries.splice(m_entries.begin(), m_entries, it->second);
+                    rotate = m_entries.front().rotate;
+                    return;
+                }
+            }
+
+            // The rotation is computed without the lock so the other threads only wait for the copies
+            setRotation(key, rotate);
+#if (__cplusplus > 199711L)
+            std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+            typename std::map<Key, Iterator>::iterator it = m_keys.find(key);
+            if(it != m_keys.end())
+            {
+                m_entries.splice(m_entries.begin(), m_entries, it->second);
+                return;
+            }
+            Iterator last = --m_entries.end();
+            if(last->valid)
+            {
+                m_keys.erase(last->key);
+            }
+            last->key    = key;
+            last->valid  = true;
+            last->rotate = rotate;
+            m_entries.splice(m_entries.begin(), m_entries, last);
+            m_keys[key] = m_entries.begin();
+        }
+
+        //! Clear the cache.
+        /** Remove all the rotations of the cache.
+         */
+        void clear()
+        {
+#if (__cplusplus > 199711L)
+            std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+            m_keys.clear();
+            for(Iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+            {
+                it->valid = false;
+            }
+        }
+    };
 }
 
 #endif
@@ -9,6 +9,8 @@
 
 #include "Encoder.hpp"
 #include "Planewaves.hpp"
+#include "Fft.hpp"
+#include "Snapshot.hpp"
 
 namespace hoa
 {
@@ -19,6 +21,15 @@ namespace hoa
     {
     public:
 
+        //! The analysis of the block processing.
+        /** The enum defines how the harmonics are summarized over a window of samples by the block processing.
+         */
+        enum Analysis
+        {
+            Energy  = 0, /*!<  The harmonics are correlated with the omnidirectional harmonic and normalized by its root mean square. */
+            Peak    = 1  /*!<  The harmonics of the sample with the highest omnidirectional absolute value are held. */
+        };
+
         //! The scope constructor.
         /**	The scope constructor allocates and initialize the member values to computes harmonics projection depending on a order of decomposition and a number of points. The order must be at least 1.
          @param     order            The order.
@@ -48,6 +59,13 @@ namespace hoa
          */
         virtual inline void process(const T* inputs, T* outputs) hoa_noexcept hoa_override = 0;
 
+        //! This method performs the harmonics projection without normalization.
+        /**	Compute the projection of the harmonics over the points in an outputs array. The values are not normalized by their maximum and the values of the points, the maximum and the analysis of the scope are not changed. The inputs array contains the harmonics samples and the minimum size must be the number of harmonics, the minimum size of the outputs array must be the number of points.
+         @param     inputs   The inputs array.
+         @param     outputs  The outputs array.
+         */
+        virtual inline void project(const T* inputs, T* outputs) hoa_noexcept = 0;
+
         //! This method performs the spherical harmonics projection with single precision.
         /**	You should use this method to compute the projection of the spherical harmonics over an ambisonic sphere. The inputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
 
@@ -55,16 +73,63 @@ namespace hoa
          */
         virtual inline void process(const T* inputs) hoa_noexcept = 0;
 
+        //! Retrieve the maximum of the projection.
+        /** Retrieve the absolute maximum of the points computed by the last projection. When the maximum is greater than 1, the points are normalized by the maximum so their values must be multiplied by it to retrieve the values of the projection.
+         @return    The maximum of the projection.
+         */
+        virtual inline T getMaximum() const hoa_noexcept = 0;
+
+        //! Set the analysis of the block processing.
+        /** Set how the harmonics are summarized over the window.
+         @param     analysis   The analysis.
+         */
+        virtual void setAnalysis(const Analysis analysis) hoa_noexcept = 0;
+
+        //! Set the size of the window of the block processing.
+        /** Set the number of samples that are summarized before the points are evaluated. The window should match the refresh rate of the graphical interface, for example 1024 samples at 44.1 kHz for a refresh rate of about 43 Hz.
+         @param     size   The number of samples of the window.
+         */
+        virtual void setWindowSize(const size_t size) hoa_noexcept = 0;
+
+        //! This method performs the analysis of a block of samples.
+        /** You should use this method to feed the scope from the digital signal processing. The harmonics are summarized over the window and the projection is only performed when the window is complete, so the cost of the scope does not depend on the sample rate. The inputs matrix contains the harmonics samples with one row per harmonic (harmonics × vector size).
+         @param     vectorsize  The vector size.
+         @param     inputs      The inputs matrix.
+         @return    true if the points have been updated, otherwise false.
+         */
+        virtual bool processBlock(const size_t vectorsize, const T* inputs) hoa_noexcept = 0;
+
     };
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
     template <typename T> class Scope<Hoa2d, T> : public Encoder<Hoa2d, T>::Basic, protected Processor<Hoa2d, T>::Planewaves
     {
+    public:
+
+        //! The analysis of the block processing.
+        /** The enum defines how the harmonics are summarized over a window of samples by the block processing.
+         */
+        enum Analysis
+        {
+            Energy  = 0, /*!<  The harmonics are correlated with the omnidirectional harmonic and normalized by its root mean square. */
+            Peak    = 1  /*!<  The harmonics of the sample with the highest omnidirectional absolute value are held. */
+        };
+
     private:
-        T*  m_matrix;
-        T*  m_vector;
+        Buffer<T> m_matrix;
+        Buffer<T> m_vector;
         T   m_maximum;
+        Analysis    m_analysis;
+        size_t      m_window;
+        size_t      m_count;
+        T           m_reference;
+        Buffer<T>   m_summary;
+#if (__cplusplus > 199711L)
+        size_t      m_time;
+        Snapshot<T> m_snapshot;
+#endif
+        FftProjection<T> m_fft;
     public:
 
         //! The scope constructor.
@@ -74,22 +139,22 @@ namespace hoa
          */
         Scope(size_t order, size_t numberOfPoints) hoa_noexcept :
         Encoder<Hoa2d, T>::Basic(order),
-        Processor<Hoa2d, T>::Planewaves(numberOfPoints)
+        Processor<Hoa2d, T>::Planewaves(numberOfPoints),
+        m_analysis(Energy),
+        m_window(1024),
+        m_count(0),
+        m_reference(0)
+#if (__cplusplus > 199711L)
+        , m_time(0)
+        , m_snapshot(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves())
+#endif
         {
-            m_matrix = Signal<T>::alloc(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves() * Encoder<Hoa2d, T>::getNumberOfHarmonics());
-            m_vector = Signal<T>::alloc(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
+            m_summary.resize(Encoder<Hoa2d, T>::getNumberOfHarmonics());
+            m_matrix.resize(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves() * Encoder<Hoa2d, T>::getNumberOfHarmonics());
+            m_vector.resize(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
             computeRendering();
         }
 
-        //! The scope destructor.
-        /**	The scope destructor free the memory.
-         */
-        ~Scope() hoa_noexcept
-        {
-            Signal<T>::free(m_matrix);
-            Signal<T>::free(m_vector);
-        }
-
         //! Set the offset.
         /**	Set the rotation of the spherical harmonics in radian.
          */
@@ -118,6 +183,7 @@ namespace hoa
                 Encoder<Hoa2d, T>::Basic::process(&factor, m_matrix + i * Encoder<Hoa2d, T>::getNumberOfHarmonics());
                 m_matrix[i * Encoder<Hoa2d, T>::getNumberOfHarmonics()] = factor * 0.5;
             }
+            m_fft.compute(Encoder<Hoa2d, T>::getDecompositionOrder(), Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(), m_matrix);
             for(size_t i = 0; i < Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(); i++)
             {
                 m_vector[i] = 0.;
@@ -190,13 +256,30 @@ namespace hoa
             return fabs(m_vector[index]) * Processor<Hoa2d, T>::Planewaves::getPlanewaveOrdinate(index);
         }
 
+        //! This method performs the circular harmonics projection without normalization.
+        /**	Compute the projection of the circular harmonics over the points of the circle in an outputs array. The values are not normalized by their maximum and the values of the points, the maximum and the analysis of the scope are not changed. The inputs array contains the circular harmonics samples and the minimum size must be the number of harmonics, the minimum size of the outputs array must be the number of points.
+         @param     inputs   The inputs array.
+         @param     outputs  The outputs array.
+         */
+        inline void project(const T* inputs, T* outputs) hoa_noexcept
+        {
+            if(m_fft.isEnabled())
+            {
+                m_fft.process(inputs, outputs);
+            }
+            else
+            {
+                Signal<T>::mul(Encoder<Hoa2d, T>::getNumberOfHarmonics(), Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(), inputs, m_matrix, outputs);
+            }
+        }
+
         //! This method performs the circular harmonics projection.
         /**	You should use this method to compute the projection of the circular harmonics over an ambisonics circle. The inputs array contains the circular harmonics samples and the minimum size must be the number of harmonics.
          @param     inputs   The inputs array.
          */
         inline void process(const T* inputs, T* outputs) hoa_noexcept hoa_override
         {
-            Signal<T>::mul(Encoder<Hoa2d, T>::getNumberOfHarmonics(), Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(), inputs, m_matrix, m_vector);
+            project(inputs, m_vector);
             m_maximum = fabs(Signal<T>::max(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(), m_vector));
             if(m_maximum > 1.)
             {
@@ -210,23 +293,181 @@ namespace hoa
          */
         inline void process(const T* inputs) hoa_noexcept
         {
-            Signal<T>::mul(Encoder<Hoa2d, T>::getNumberOfHarmonics(), Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(), inputs, m_matrix, m_vector);
+            project(inputs, m_vector);
             m_maximum = fabs(Signal<T>::max(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(), m_vector));
             if(m_maximum > 1.)
             {
                 Signal<T>::scale(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(), (1. / m_maximum), m_vector);
             }
         }
+
+        //! Retrieve the maximum of the projection.
+        /** Retrieve the absolute maximum of the points computed by the last projection. When the maximum is greater than 1, the points are normalized by the maximum so their values must be multiplied by it to retrieve the values of the projection.
+         @return    The maximum of the projection.
+         */
+        inline T getMaximum() const hoa_noexcept
+        {
+            return m_maximum;
+        }
+
+        //! Check if the projection uses the fft.
+        /** Check if the projection is computed with a fast Fourier transform rather than with the matrix. The fft is enabled by the computeRendering method when the points are regular and when the transform is cheaper than the matrix.
+         @return    true if the projection uses the fft, otherwise false.
+         */
+        inline bool isFftEnabled() const hoa_noexcept
+        {
+            return m_fft.isEnabled();
+        }
+
+        //! Set the analysis of the block processing.
+        /** Set how the harmonics are summarized over the window. The current window is restarted.
+         @param     analysis   The analysis.
+         */
+        inline void setAnalysis(const Analysis analysis) hoa_noexcept
+        {
+            m_analysis = analysis;
+            m_count = 0;
+        }
+
+        //! Get the analysis of the block processing.
+        /** Get how the harmonics are summarized over the window.
+         @return    The analysis.
+         */
+        inline Analysis getAnalysis() const hoa_noexcept
+        {
+            return m_analysis;
+        }
+
+        //! Set the size of the window of the block processing.
+        /** Set the number of samples that are summarized before the points are evaluated. The window should match the refresh rate of the graphical interface, for example 1024 samples at 44.1 kHz for a refresh rate of about 43 Hz. The current window is restarted.
+         @param     size   The number of samples of the window.
+         */
+        inline void setWindowSize(const size_t size) hoa_noexcept
+        {
+            m_window = size ? size : 1;
+            m_count = 0;
+        }
+
+        //! Get the size of the window of the block processing.
+        /** Get the number of samples that are summarized before the points are evaluated.
+         @return    The number of samples of the window.
+         */
+        inline size_t getWindowSize() const hoa_noexcept
+        {
+            return m_window;
+        }
+
+        //! This method performs the analysis of a block of samples.
+        /** You should use this method to feed the scope from the digital signal processing. The harmonics are summarized over the window and the projection is only performed when the window is complete, so the cost of the scope does not depend on the sample rate. The inputs matrix contains the harmonics samples with one row per harmonic (harmonics × vector size).
+         @param     vectorsize  The vector size.
+         @param     inputs      The inputs matrix.
+         @return    true if the points have been updated, otherwise false.
+         */
+        bool processBlock(const size_t vectorsize, const T* inputs) hoa_noexcept
+        {
+            const size_t nharmonics = Encoder<Hoa2d, T>::getNumberOfHarmonics();
+            bool updated = false;
+            size_t offset = 0;
+            while(offset < vectorsize)
+            {
+                if(m_count == 0)
+                {
+                    Signal<T>::clear(nharmonics, m_summary);
+                    m_reference = 0;
+                }
+                const size_t size = (vectorsize - offset < m_window - m_count) ? vectorsize - offset : m_window - m_count;
+                const T* omni = inputs + offset;
+                if(m_analysis == Energy)
+                {
+                    for(size_t i = 0; i < nharmonics; i++)
+                    {
+                        m_summary[i] += Signal<T>::dot(size, inputs + i * vectorsize + offset, omni);
+                    }
+                    m_reference += Signal<T>::dot(size, omni, omni);
+                }
+                else
+                {
+                    for(size_t i = 0; i < size; i++)
+                    {
+                        if(fabs(omni[i]) > m_reference)
+                        {
+                            m_reference = fabs(omni[i]);
+                            Signal<T>::copy(nharmonics, omni + i, vectorsize, m_summary, 1);
+                        }
+                    }
+                }
+                m_count += size;
+                offset  += size;
+#if (__cplusplus > 199711L)
+                m_time  += size;
+#endif
+                if(m_count == m_window)
+                {
+                    if(m_analysis == Energy)
+                    {
+                        const T rms = sqrt(m_reference * T(m_window));
+                        Signal<T>::scale(nharmonics, rms > 0 ? T(1.) / rms : T(0.), m_summary);
+                    }
+                    process(m_summary);
+#if (__cplusplus > 199711L)
+                    Signal<T>::copy(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves(), m_vector, m_snapshot.write());
+                    m_snapshot.publish(m_time);
+#endif
+                    m_count = 0;
+                    updated = true;
+                }
+            }
+            return updated;
+        }
+
+#if (__cplusplus > 199711L)
+        //! Get the snapshot of the scope.
+        /** Get the snapshot that the processBlock method publishes at the end of each window. A graphical interface or a monitoring thread should poll the snapshot instead of calling getPointValue while the audio thread processes. A set of values contains the values of the points in the same order as the projection, its time is the number of samples processed.
+         @return The snapshot of the scope.
+         */
+        inline Snapshot<T>& getSnapshot() hoa_noexcept
+        {
+            return m_snapshot;
+        }
+#endif
+
     };
 
     template <typename T> class Scope<Hoa3d, T> : public Encoder<Hoa3d, T>::Basic, protected Processor<Hoa3d, T>::Planewaves
     {
+    public:
+
+        //! The analysis of the block processing.
+        /** The enum defines how the harmonics are summarized over a window of samples by the block processing.
+         */
+        enum Analysis
+        {
+            Energy  = 0, /*!<  The harmonics are correlated with the omnidirectional harmonic and normalized by its root mean square. */
+            Peak    = 1  /*!<  The harmonics of the sample with the highest omnidirectional absolute value are held. */
+        };
+
     private:
-        const size_t m_number_of_rows;
-        const size_t m_number_of_columns;
-        T*  m_matrix;
-        T*  m_vector;
+        size_t       m_number_of_rows;
+        size_t       m_number_of_columns;
+        Buffer<T> m_matrix;
+        Buffer<T> m_vector;
         T   m_maximum;
+        Analysis            m_analysis;
+        size_t              m_window;
+        size_t              m_count;
+        T                   m_reference;
+        Buffer<T>           m_summary;
+#if (__cplusplus > 199711L)
+        size_t              m_time;
+        Snapshot<T>         m_snapshot;
+#endif
+        bool                m_separable;
+        Buffer<T>           m_legendre;
+        Buffer<T>           m_fourier;
+        Buffer<T>           m_coefficients;
+        std::vector<size_t> m_indices;
+        FftProjection<T>    m_fft;
+
     public:
 
         //! The Scope constructor.
@@ -240,8 +481,18 @@ namespace hoa
         Encoder<Hoa3d, T>::Basic(order),
         Processor<Hoa3d, T>::Planewaves(numberOfRow * numberOfColumn),
         m_number_of_rows(numberOfRow),
-        m_number_of_columns(numberOfColumn)
+        m_number_of_columns(numberOfColumn),
+        m_analysis(Energy),
+        m_window(1024),
+        m_count(0),
+        m_reference(0),
+#if (__cplusplus > 199711L)
+        m_time(0),
+        m_snapshot(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves()),
+#endif
+        m_separable(false)
         {
+            m_summary.resize(Encoder<Hoa3d, T>::getNumberOfHarmonics());
             for(size_t i = 0; i < m_number_of_rows; i++)
             {
                 const T elevation = (T)i  * HOA_PI / (T)(m_number_of_rows - 1) - HOA_PI2;
@@ -252,20 +503,10 @@ namespace hoa
                 }
             }
 
-            m_matrix = Signal<T>::alloc(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves() * Encoder<Hoa3d, T>::getNumberOfHarmonics());
-            m_vector = Signal<T>::alloc(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
+            m_vector.resize(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
             computeRendering();
         }
 
-        //! The scope destructor.
-        /**	The scope destructor free the memory.
-         */
-        ~Scope() hoa_noexcept
-        {
-            Signal<T>::free(m_matrix);
-            Signal<T>::free(m_vector);
-        }
-
         //! Retrieve the number of rows.
         /**	Retrieve the number of rows used to discretize the ambisonic sphere.
 
@@ -383,25 +624,76 @@ namespace hoa
          */
         void computeRendering() hoa_noexcept
         {
-            const T factor = 12.5 / (T)(Encoder<Hoa3d, T>::getNumberOfHarmonics());
-            for(size_t i = 0; i < Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves(); i++)
+            const size_t nharmonics = Encoder<Hoa3d, T>::getNumberOfHarmonics();
+            const size_t* degrees   = Encoder<Hoa3d, T>::getHarmonicTable().getDegrees();
+            const long* orders      = Encoder<Hoa3d, T>::getHarmonicTable().getOrders();
+            T* weights = Signal<T>::alloc(nharmonics);
+            for(size_t j = 0; j < nharmonics; j++)
             {
-                Encoder<Hoa3d, T>::Basic::setAzimuth(Processor<Hoa3d, T>::Planewaves::getPlanewaveAzimuth(i));
-                Encoder<Hoa3d, T>::Basic::setElevation(Processor<Hoa3d, T>::Planewaves::getPlanewaveElevation(i));
-                Encoder<Hoa3d, T>::Basic::process(&factor, m_matrix + i * Encoder<Hoa3d, T>::getNumberOfHarmonics());
-                for(size_t j = 0; j < Encoder<Hoa3d, T>::getNumberOfHarmonics(); j++)
+                weights[j] = (orders[j] == 0) ? T(2. * degrees[j] + 1.) : T(2. * degrees[j] + 1.) * T(4. * HOA_PI);
+            }
+            const T factor = 12.5 / (T)(nharmonics);
+            m_separable = (Processor<Hoa3d, T>::Planewaves::getPlanewavesRotationX() == 0 && Processor<Hoa3d, T>::Planewaves::getPlanewavesRotationY() == 0);
+            if(m_separable)
+            {
+                const size_t order     = Encoder<Hoa3d, T>::getDecompositionOrder();
+                const size_t ncircular = order * 2 + 1;
+                m_matrix.resize(0);
+                m_legendre.resize(m_number_of_rows * nharmonics);
+                m_coefficients.resize(m_number_of_rows * ncircular);
+                m_indices.resize(nharmonics);
+                for(size_t j = 0; j < nharmonics; j++)
                 {
-                    const size_t l = Encoder<Hoa3d, T>::getHarmonicDegree(j);
-                    if(Encoder<Hoa3d, T>::getHarmonicOrder(j) == 0)
+                    m_indices[j] = (orders[j] < 0) ? size_t(-orders[j] * 2 - 1) : size_t(orders[j] * 2);
+                }
+                Encoder<Hoa3d, T>::Basic::setAzimuth(0.);
+                for(size_t i = 0; i < m_number_of_rows; i++)
+                {
+                    T* row = m_legendre + i * nharmonics;
+                    Encoder<Hoa3d, T>::Basic::setElevation(Processor<Hoa3d, T>::Planewaves::getPlanewaveElevation(i * m_number_of_columns));
+                    Encoder<Hoa3d, T>::Basic::process(&factor, row);
+                    for(size_t j = 0; j < nharmonics; j++)
+                    {
+                        // At the azimuth 0, the sine harmonics are null so they use the values of the cosine harmonics.
+                        row[j] = (orders[j] < 0) ? row[j + size_t(-2 * orders[j])] * weights[j] : row[j] * weights[j];
+                    }
+                }
+                // The azimuths are read on the middle row because the azimuths of the poles are undefined.
+                const size_t middle = (m_number_of_rows / 2) * m_number_of_columns;
+                Buffer<T> columns(m_number_of_columns * ncircular);
+                m_fourier.resize(ncircular * m_number_of_columns);
+                for(size_t i = 0; i < m_number_of_columns; i++)
+                {
+                    const T azimuth = Processor<Hoa3d, T>::Planewaves::getPlanewaveAzimuth(middle + i);
+                    columns[i * ncircular] = 1.;
+                    for(size_t j = 1; j <= order; j++)
                     {
-                        m_matrix[i * Encoder<Hoa3d, T>::getNumberOfHarmonics() + j] *= (2. * l + 1.);
+                        columns[i * ncircular + 2 * j - 1] = std::sin(T(j) * azimuth);
+                        columns[i * ncircular + 2 * j]     = std::cos(T(j) * azimuth);
                     }
-                    else
+                    for(size_t j = 0; j < ncircular; j++)
+                    {
+                        m_fourier[j * m_number_of_columns + i] = columns[i * ncircular + j];
+                    }
+                }
+                m_fft.compute(order, m_number_of_columns, columns);
+            }
+            else
+            {
+                m_matrix.resize(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves() * nharmonics);
+                for(size_t i = 0; i < Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves(); i++)
+                {
+                    T* row = m_matrix + i * nharmonics;
+                    Encoder<Hoa3d, T>::Basic::setAzimuth(Processor<Hoa3d, T>::Planewaves::getPlanewaveAzimuth(i));
+                    Encoder<Hoa3d, T>::Basic::setElevation(Processor<Hoa3d, T>::Planewaves::getPlanewaveElevation(i));
+                    Encoder<Hoa3d, T>::Basic::process(&factor, row);
+                    for(size_t j = 0; j < nharmonics; j++)
                     {
-                        m_matrix[i * Encoder<Hoa3d, T>::getNumberOfHarmonics() + j] *= T(2. * l + 1.) * 4. * HOA_PI;
+                        row[j] *= weights[j];
                     }
                 }
             }
+            Signal<T>::free(weights);
             for(size_t i = 0; i < Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves(); i++)
             {
                 m_vector[i] = 0.;
@@ -409,6 +701,44 @@ namespace hoa
             m_maximum = 0;
         }
 
+        //! This method performs the spherical harmonics projection without normalization.
+        /**	Compute the projection of the spherical harmonics over the points of the sphere in an outputs array. The values are not normalized by their maximum and the values of the points, the maximum and the analysis of the scope are not changed. When the view is only rotated around the z axis, the harmonics are separable. The harmonics are first summed per row with the Legendre values of the elevation of the row, that gives the circular harmonics of each row. The circular harmonics are then projected on the columns with the Fourier matrix or with the fft projection. Otherwise the harmonics are projected with the dense matrix. The inputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics, the minimum size of the outputs array must be the number of points.
+         @param     inputs   The inputs array.
+         @param     outputs  The outputs array.
+         */
+        inline void project(const T* inputs, T* outputs) hoa_noexcept
+        {
+            const size_t nharmonics = Encoder<Hoa3d, T>::getNumberOfHarmonics();
+            if(m_separable)
+            {
+                const size_t ncircular = Encoder<Hoa3d, T>::getDecompositionOrder() * 2 + 1;
+                Signal<T>::clear(m_number_of_rows * ncircular, m_coefficients);
+                for(size_t i = 0; i < m_number_of_rows; i++)
+                {
+                    const T* row = m_legendre + i * nharmonics;
+                    T* coefficients = m_coefficients + i * ncircular;
+                    for(size_t j = 0; j < nharmonics; j++)
+                    {
+                        coefficients[m_indices[j]] += inputs[j] * row[j];
+                    }
+                }
+                if(m_fft.isEnabled())
+                {
+                    for(size_t i = 0; i < m_number_of_rows; i++)
+                    {
+                        m_fft.process(m_coefficients + i * ncircular, outputs + i * m_number_of_columns);
+                    }
+                }
+                else
+                {
+                    Signal<T>::mul(m_number_of_rows, m_number_of_columns, ncircular, m_coefficients, m_fourier, outputs);
+                }
+            }
+            else
+            {
+                Signal<T>::mul(nharmonics, Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves(), inputs, m_matrix, outputs);
+            }
+        }
         //! This method performs the spherical harmonics projection with single precision.
         /**	You should use this method to compute the projection of the spherical harmonics over an ambisonic sphere. The inputs array contains the spherical harmonics samples and the minimum size must be the number of harmonics.
 
@@ -416,7 +746,7 @@ namespace hoa
          */
         inline void process(const T* inputs, T* outputs) hoa_noexcept hoa_override
         {
-            Signal<T>::mul(Encoder<Hoa3d, T>::getNumberOfHarmonics(), Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves(), inputs, m_matrix, m_vector);
+            project(inputs, m_vector);
             m_maximum = fabs(Signal<T>::max(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves(), m_vector));
             if(m_maximum > 1.)
             {
@@ -431,13 +761,135 @@ namespace hoa
          */
         inline void process(const T* inputs) hoa_noexcept
         {
-            Signal<T>::mul(Encoder<Hoa3d, T>::getNumberOfHarmonics(), Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves(), inputs, m_matrix, m_vector);
+            project(inputs, m_vector);
             m_maximum = fabs(Signal<T>::max(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves(), m_vector));
             if(m_maximum > 1.)
             {
                 Signal<T>::scale(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves(), (1. / m_maximum), m_vector);
             }
         }
+
+        //! Retrieve the maximum of the projection.
+        /** Retrieve the absolute maximum of the points computed by the last projection. When the maximum is greater than 1, the points are normalized by the maximum so their values must be multiplied by it to retrieve the values of the projection.
+         @return    The maximum of the projection.
+         */
+        inline T getMaximum() const hoa_noexcept
+        {
+            return m_maximum;
+        }
+
+        //! Set the analysis of the block processing.
+        /** Set how the harmonics are summarized over the window. The current window is restarted.
+         @param     analysis   The analysis.
+         */
+        inline void setAnalysis(const Analysis analysis) hoa_noexcept
+        {
+            m_analysis = analysis;
+            m_count = 0;
+        }
+
+        //! Get the analysis of the block processing.
+        /** Get how the harmonics are summarized over the window.
+         @return    The analysis.
+         */
+        inline Analysis getAnalysis() const hoa_noexcept
+        {
+            return m_analysis;
+        }
+
+        //! Set the size of the window of the block processing.
+        /** Set the number of samples that are summarized before the points are evaluated. The window should match the refresh rate of the graphical interface, for example 1024 samples at 44.1 kHz for a refresh rate of about 43 Hz. The current window is restarted.
+         @param     size   The number of samples of the window.
+         */
+        inline void setWindowSize(const size_t size) hoa_noexcept
+        {
+            m_window = size ? size : 1;
+            m_count = 0;
+        }
+
+        //! Get the size of the window of the block processing.
+        /** Get the number of samples that are summarized before the points are evaluated.
+         @return    The number of samples of the window.
+         */
+        inline size_t getWindowSize() const hoa_noexcept
+        {
+            return m_window;
+        }
+
+        //! This method performs the analysis of a block of samples.
+        /** You should use this method to feed the scope from the digital signal processing. The harmonics are summarized over the window and the projection is only performed when the window is complete, so the cost of the scope does not depend on the sample rate. The inputs matrix contains the harmonics samples with one row per harmonic (harmonics × vector size).
+         @param     vectorsize  The vector size.
+         @param     inputs      The inputs matrix.
+         @return    true if the points have been updated, otherwise false.
+         */
+        bool processBlock(const size_t vectorsize, const T* inputs) hoa_noexcept
+        {
+            const size_t nharmonics = Encoder<Hoa3d, T>::getNumberOfHarmonics();
+            bool updated = false;
+            size_t offset = 0;
+            while(offset < vectorsize)
+            {
+                if(m_count == 0)
+                {
+                    Signal<T>::clear(nharmonics, m_summary);
+                    m_reference = 0;
+                }
+                const size_t size = (vectorsize - offset < m_window - m_count) ? vectorsize - offset : m_window - m_count;
+                const T* omni = inputs + offset;
+                if(m_analysis == Energy)
+                {
+                    for(size_t i = 0; i < nharmonics; i++)
+                    {
+                        m_summary[i] += Signal<T>::dot(size, inputs + i * vectorsize + offset, omni);
+                    }
+                    m_reference += Signal<T>::dot(size, omni, omni);
+                }
+                else
+                {
+                    for(size_t i = 0; i < size; i++)
+                    {
+                        if(fabs(omni[i]) > m_reference)
+                        {
+                            m_reference = fabs(omni[i]);
+                            Signal<T>::copy(nharmonics, omni + i, vectorsize, m_summary, 1);
+                        }
+                    }
+                }
+                m_count += size;
+                offset  += size;
+#if (__cplusplus > 199711L)
+                m_time  += size;
+#endif
+                if(m_count == m_window)
+                {
+                    if(m_analysis == Energy)
+                    {
+                        const T rms = sqrt(m_reference * T(m_window));
+                        Signal<T>::scale(nharmonics, rms > 0 ? T(1.) / rms : T(0.), m_summary);
+                    }
+                    process(m_summary);
+#if (__cplusplus > 199711L)
+                    Signal<T>::copy(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves(), m_vector, m_snapshot.write());
+                    m_snapshot.publish(m_time);
+#endif
+                    m_count = 0;
+                    updated = true;
+                }
+            }
+            return updated;
+        }
+
+#if (__cplusplus > 199711L)
+        //! Get the snapshot of the scope.
+        /** Get the snapshot that the processBlock method publishes at the end of each window. A graphical interface or a monitoring thread should poll the snapshot instead of calling getPointValue while the audio thread processes. A set of values contains the values of the points in the same order as the projection, its time is the number of samples processed.
+         @return The snapshot of the scope.
+         */
+        inline Snapshot<T>& getSnapshot() hoa_noexcept
+        {
+            return m_snapshot;
+        }
+#endif
+
     };
 
 #endif
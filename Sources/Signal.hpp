@@ -89,6 +89,21 @@ namespace hoa
             }
         }
 
+        //! Multiplies a vector by a vector.
+        /** Multiplies a vector by a vector element by element.
+        @param size     The size of the vectors.
+        @param in1      The first vector.
+        @param in2      The second vector.
+        @param output   The output vector.
+         */
+        static inline void mul(const size_t size, const T* in1, const T* in2, T* output) hoa_noexcept
+        {
+            for(size_t i = 0; i < size; i++)
+            {
+                output[i] = in1[i] * in2[i];
+            }
+        }
+
         //! Multiplies a matrix by a matrix.
         /** Multiplies a matrix by a matrix.
         @param m        The number of rows in the first matrix and the number of columns in the second matrix.
@@ -102,23 +117,27 @@ namespace hoa
         {
             size_t i, j, k;
             memset(output, 0, m * n * sizeof(T));
-            T* out = output;
             for(k = 0; k < l; k++)
             {
-                out = output;
+                const T* in_row = in2 + n * k;
                 for(i = 0; i < m; i++)
                 {
                     const T g0 = in1[l * i + k];
                     if(g0 != 0)
                     {
-                        const T* in = in2+n*k;
-                        for(j = n; j; j -= 8, out += 8, in += 8)
+                        T* out = output + n * i;
+                        const T* in = in_row;
+                        for(j = n>>3; j; --j, out += 8, in += 8)
                         {
                             const T f0 = in[0] * g0, f1 = in[1] * g0, f2 = in[2] * g0, f3 = in[3] * g0;
                             const T f4 = in[4] * g0, f5 = in[5] * g0, f6 = in[6] * g0, f7 = in[7] * g0;
                             out[0] += f0; out[1] += f1; out[2] += f2; out[3] += f3;
                             out[4] += f4; out[5] += f5; out[6] += f6; out[7] += f7;
                         }
+                        for(j = n&7; j; --j, out++, in++)
+                        {
+                            out[0] += in[0] * g0;
+                        }
                     }
                 }
             }
@@ -132,16 +151,42 @@ namespace hoa
          */
         static inline T max(const size_t vectorsize, const T* vector) hoa_noexcept
         {
-            T max = fabs(vector[0]);
-            for(size_t i = 1ul; i < vectorsize; i++)
+            T max0 = 0, max1 = 0, max2 = 0, max3 = 0;
+            for(size_t i = vectorsize>>2; i; --i, vector += 4)
             {
-                const T temp = fabs(vector[i]);
-                if(temp > max)
-                {
-                    max = temp;
-                }
+                const T temp0 = fabs(vector[0]), temp1 = fabs(vector[1]), temp2 = fabs(vector[2]), temp3 = fabs(vector[3]);
+                max0 = temp0 > max0 ? temp0 : max0; max1 = temp1 > max1 ? temp1 : max1;
+                max2 = temp2 > max2 ? temp2 : max2; max3 = temp3 > max3 ? temp3 : max3;
+            }
+            for(size_t i = vectorsize&3; i; --i, vector++)
+            {
+                const T temp = fabs(vector[0]);
+                max0 = temp > max0 ? temp : max0;
+            }
+            max0 = max1 > max0 ? max1 : max0;
+            max2 = max3 > max2 ? max3 : max2;
+            return max2 > max0 ? max2 : max0;
+        }
+
+        //! Computes the sum of the squares of each element of a vector.
+        /** Computes the sum of the squares of each element of a vector.
+        @param   size   The size of the vector.
+        @param   vector The vector.
+        @return  The sum of the squares of each element of the vector
+         */
+        static inline T energy(const size_t size, const T* vector) hoa_noexcept
+        {
+            T sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+            for(size_t i = size>>2; i; --i, vector += 4)
+            {
+                sum0 += vector[0] * vector[0]; sum1 += vector[1] * vector[1];
+                sum2 += vector[2] * vector[2]; sum3 += vector[3] * vector[3];
+            }
+            for(size_t i = size&3; i; --i, vector++)
+            {
+                sum0 += vector[0] * vector[0];
             }
-            return max;
+            return (sum0 + sum1) + (sum2 + sum3);
         }
 
         //! Computes the sum of each element of a vector.
@@ -174,6 +219,44 @@ namespace hoa
             }
         }
 
+        //! Multiplies each element of a vector by a factor into an other vector.
+        /** Multiplies each element of a vector by a factor into an other vector.
+        @param   size   The size of the vectors.
+        @param   factor The factor of the scale.
+        @param   in     The source vector.
+        @param   out    The destination vector.
+         */
+        static inline void scale(const size_t size, const T factor, const T* in, T* out) hoa_noexcept
+        {
+            for(size_t i = size>>3; i; --i, in += 8, out += 8)
+            {
+                out[0] = in[0] * factor; out[1] = in[1] * factor; out[2] = in[2] * factor; out[3] = in[3] * factor;
+                out[4] = in[4] * factor; out[5] = in[5] * factor; out[6] = in[6] * factor; out[7] = in[7] * factor;
+            }
+            for(size_t i = size&7; i; --i, in++, out++)
+            {
+                out[0] = in[0] * factor;
+            }
+        }
+
+        //! Checks if a vector is silent.
+        /** Checks if all the elements of a vector are equal to zero.
+        @param   size   The size of the vector.
+        @param   vector The vector.
+        @return  true if all the elements are equal to zero, otherwise false.
+         */
+        static inline bool isZero(const size_t size, const T* vector) hoa_noexcept
+        {
+            for(size_t i = 0ul; i < size; i++)
+            {
+                if(vector[i] != 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
         //! Clears a vector.
         /** Clears a vector.
         @param   size   The size of the vector.
@@ -195,6 +278,17 @@ namespace hoa
             memcpy(dest, source, size * sizeof(T));
         }
 
+        //! Moves a vector into an other that may overlap.
+        /** Copies a vector into an other, the source and the destination may overlap, for example to shift the content of a vector.
+        @param   size   The size of the vectors.
+        @param   source The source vector.
+        @param   dest   The destination vector.
+         */
+        static inline void move(const size_t size, const T* source, T* dest) hoa_noexcept
+        {
+            memmove(dest, source, size * sizeof(T));
+        }
+
         //! Copies a vector into an other.
         /** Copies a vector into an other.
          @param   size   The size of the vectors.
@@ -276,6 +370,164 @@ namespace hoa
             return result;
         }
     };
+
+    //! The buffer class owns an aligned vector.
+    /** The buffer allocates its vector with the signal class and frees it when it is destroyed. A copy of a buffer owns a copy of the vector and, with C++11 and later, a moved buffer gives its vector to the new one, so the processors that own buffers can be copied, moved and stored by value in containers.
+     */
+    template<typename T> class Buffer
+    {
+    private:
+        T*      m_vector;
+        size_t  m_size;
+    public:
+
+        //! The buffer constructor.
+        /** The buffer constructor allocates and clears a vector.
+         @param size  The size of the vector.
+         */
+        explicit Buffer(const size_t size = 0ul) hoa_noexcept :
+        m_vector(size ? Signal<T>::alloc(size) : hoa_nullptr),
+        m_size(size)
+        {
+            ;
+        }
+
+        //! The buffer copy constructor.
+        /** The buffer copy constructor allocates a vector and copies the vector of another buffer.
+         @param other  The other buffer.
+         */
+        Buffer(const Buffer& other) hoa_noexcept :
+        m_vector(other.m_size ? Signal<T>::alloc(other.m_size) : hoa_nullptr),
+        m_size(other.m_size)
+        {
+            if(m_vector)
+            {
+                Signal<T>::copy(m_size, other.m_vector, m_vector);
+            }
+        }
+
+#if (__cplusplus > 199711L)
+        //! The buffer move constructor.
+        /** The buffer move constructor takes the vector of another buffer.
+         @param other  The other buffer.
+         */
+        Buffer(Buffer&& other) hoa_noexcept :
+        m_vector(other.m_vector),
+        m_size(other.m_size)
+        {
+            other.m_vector = hoa_nullptr;
+            other.m_size   = 0ul;
+        }
+
+        //! The buffer move assignment.
+        /** The buffer move assignment frees the vector and takes the vector of another buffer.
+         @param other  The other buffer.
+         @return The buffer.
+         */
+        Buffer& operator=(Buffer&& other) hoa_noexcept
+        {
+            if(this != &other)
+            {
+                Signal<T>::free(m_vector);
+                m_vector = other.m_vector;
+                m_size   = other.m_size;
+                other.m_vector = hoa_nullptr;
+                other.m_size   = 0ul;
+            }
+            return *this;
+        }
+#endif
+
+        //! The buffer copy assignment.
+        /** The buffer copy assignment copies the vector of another buffer. The vector is only reallocated if the sizes differ.
+         @param other  The other buffer.
+         @return The buffer.
+         */
+        Buffer& operator=(const Buffer& other) hoa_noexcept
+        {
+            if(this != &other)
+            {
+                if(m_size != other.m_size)
+                {
+                    resize(other.m_size);
+                }
+                if(m_vector)
+                {
+                    Signal<T>::copy(m_size, other.m_vector, m_vector);
+                }
+            }
+            return *this;
+        }
+
+        //! The buffer destructor.
+        /** The buffer destructor frees the vector.
+         */
+        ~Buffer() hoa_noexcept
+        {
+            Signal<T>::free(m_vector);
+        }
+
+        //! Reallocates the vector.
+        /** Frees the vector and allocates a new cleared one, a size of zero only frees the vector.
+         @param size  The new size of the vector.
+         */
+        inline void resize(const size_t size) hoa_noexcept
+        {
+            m_vector = Signal<T>::free(m_vector);
+            m_size   = size;
+            if(m_size)
+            {
+                m_vector = Signal<T>::alloc(m_size);
+            }
+        }
+
+        //! Gets the size of the vector.
+        /** Gets the size of the vector.
+         @return The size of the vector.
+         */
+        inline size_t size() const hoa_noexcept
+        {
+            return m_size;
+        }
+
+        //! Gets a value of the vector.
+        /** Gets a value of the vector.
+         @param index  The index of the value.
+         @return The value.
+         */
+        inline T& operator[](const size_t index) hoa_noexcept
+        {
+            return m_vector[index];
+        }
+
+        //! Gets a value of the vector.
+        /** Gets a value of the vector.
+         @param index  The index of the value.
+         @return The value.
+         */
+        inline const T& operator[](const size_t index) const hoa_noexcept
+        {
+            return m_vector[index];
+        }
+
+        //! Gets the vector.
+        /** Gets the vector.
+         @return The vector.
+         */
+        inline operator T*() hoa_noexcept
+        {
+            return m_vector;
+        }
+
+        //! Gets the vector.
+        /** Gets the vector.
+         @return The vector.
+         */
+        inline operator const T*() const hoa_noexcept
+        {
+            return m_vector;
+        }
+    };
 }
 
 #endif
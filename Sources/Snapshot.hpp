@@ -0,0 +1,150 @@
+/*
+// Copyright (c) 2012-2015 Pierre Guillot, Eliott Paris & Thomas Le Meur CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef DEF_HOA_SNAPSHOT_LIGHT
+#define DEF_HOA_SNAPSHOT_LIGHT
+
+#include "Signal.hpp"
+
+#if (__cplusplus > 199711L)
+#include <atomic>
+
+namespace hoa
+{
+    //! The snapshot class publishes the results of a processor from one thread to another.
+    /** The snapshot should be used to pass the values computed by the audio thread, for example the peaks of a meter or the points of a scope, to a graphical interface or a monitoring thread. One thread (the writer) fills the values and publishes them once per display period, another thread (the reader) polls the last published values. The snapshot owns three sets of values: the writer fills one set, the reader reads another one and the third one holds the last published set. Publishing and polling only swap the sets with one atomic exchange, so none of the methods lock or wait, the writer never overwrites the values read and the reader always gets a complete set of values with the time of its publication.
+     */
+    template <typename T> class Snapshot
+    {
+    private:
+        static const size_t m_dirty = 4ul;
+
+        size_t              m_size;
+        Buffer<T>           m_values;
+        size_t              m_times[3];
+        size_t              m_back;
+        size_t              m_front;
+        std::atomic<size_t> m_middle;
+
+    public:
+
+        //! The snapshot constructor.
+        /**	The snapshot constructor allocates the three sets of values, the allocation clears them. A snapshot without values doesn't allocate anything.
+         @param     size    The number of values of a set.
+         */
+        Snapshot(const size_t size = 0ul) hoa_noexcept :
+        m_size(size),
+        m_values(size * 3ul),
+        m_back(0ul),
+        m_front(1ul),
+        m_middle(2ul)
+        {
+            m_times[0] = m_times[1] = m_times[2] = 0ul;
+        }
+
+        //! The snapshot copy constructor.
+        /**	The snapshot copy constructor allocates the same number of values as the other snapshot, the allocation clears them and nothing is published yet.
+         @param     other   The other snapshot.
+         */
+        Snapshot(const Snapshot& other) hoa_noexcept :
+        m_size(other.m_size),
+        m_values(other.m_size * 3ul),
+        m_back(0ul),
+        m_front(1ul),
+        m_middle(2ul)
+        {
+            m_times[0] = m_times[1] = m_times[2] = 0ul;
+        }
+
+        //! The snapshot assignment.
+        /**	The snapshot assignment reallocates the values if the sizes differ or clears them otherwise, nothing is published yet. It must not be called while the snapshot is written or read.
+         @param     other   The other snapshot.
+         */
+        Snapshot& operator=(const Snapshot& other) hoa_noexcept
+        {
+            if(this != &other)
+            {
+                if(m_size != other.m_size)
+                {
+                    m_size = other.m_size;
+                    m_values.resize(m_size * 3ul);
+                }
+                else if(m_size)
+                {
+                    Signal<T>::clear(m_size * 3ul, m_values);
+                }
+                m_times[0] = m_times[1] = m_times[2] = 0ul;
+                m_back  = 0ul;
+                m_front = 1ul;
+                m_middle.store(2ul, std::memory_order_relaxed);
+            }
+            return *this;
+        }
+
+        //! Retrieve the number of values.
+        /** Retrieve the number of values of a set.
+         @return The number of values.
+         */
+        inline size_t getSize() const hoa_noexcept
+        {
+            return m_size;
+        }
+
+        //! Retrieve the values to write.
+        /** Retrieve the set of values that the writer fills before publishing it. The set is not reset, it still contains the values of an older publication. This method must only be called by the writer.
+         @return The values to write.
+         */
+        inline T* write() hoa_noexcept
+        {
+            return m_values + m_back * m_size;
+        }
+
+        //! Publish the written values.
+        /** Publish the set of values that has been written with the time of the publication, for example the number of samples processed. A set that has been published but not polled yet is replaced. This method must only be called by the writer.
+         @param     time    The time of the publication.
+         */
+        inline void publish(const size_t time) hoa_noexcept
+        {
+            m_times[m_back] = time;
+            m_back = m_middle.exchange(m_back | m_dirty, std::memory_order_acq_rel) & (m_dirty - 1ul);
+        }
+
+        //! Poll the last published values.
+        /** Retrieve the last published set of values, if any, so the values and the time returned by read and getTime are updated. This method must only be called by the reader.
+         @return true if a new set of values has been published since the last poll, otherwise false.
+         */
+        inline bool poll() hoa_noexcept
+        {
+            if(!(m_middle.load(std::memory_order_relaxed) & m_dirty))
+            {
+                return false;
+            }
+            m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & (m_dirty - 1ul);
+            return true;
+        }
+
+        //! Retrieve the values read.
+        /** Retrieve the set of values retrieved by the last poll. The values stay valid until the next poll. This method must only be called by the reader.
+         @return The values read.
+         */
+        inline const T* read() const hoa_noexcept
+        {
+            return m_values + m_front * m_size;
+        }
+
+        //! Retrieve the time of the values read.
+        /** Retrieve the time of the publication of the set of values retrieved by the last poll. This method must only be called by the reader.
+         @return The time of the values read.
+         */
+        inline size_t getTime() const hoa_noexcept
+        {
+            return m_times[m_front];
+        }
+    };
+}
+
+#endif
+#endif
@@ -110,10 +110,10 @@ namespace hoa
     {
 
     private:
-        const size_t m_number_of_sources;
-        T*      m_values_old;
-        T*      m_values_new;
-        T*      m_values_step;
+        size_t       m_number_of_sources;
+        Buffer<T> m_values_old;
+        Buffer<T> m_values_new;
+        Buffer<T> m_values_step;
         size_t   m_counter;
         size_t   m_ramp;
 
@@ -125,19 +125,9 @@ namespace hoa
         PolarLines(size_t numberOfSources) hoa_noexcept :
         m_number_of_sources(numberOfSources)
         {
-            m_values_old    = Signal<T>::alloc(m_number_of_sources * 2);
-            m_values_new    = Signal<T>::alloc(m_number_of_sources * 2);
-            m_values_step   = Signal<T>::alloc(m_number_of_sources * 2);
-        }
-
-        //! The destructor.
-        /** The destructor free the memory.
-         */
-        ~PolarLines()
-        {
-            Signal<T>::free(m_values_old);
-            Signal<T>::free(m_values_new);
-            Signal<T>::free(m_values_step);
+            m_values_old.resize(m_number_of_sources * 2);
+            m_values_new.resize(m_number_of_sources * 2);
+            m_values_step.resize(m_number_of_sources * 2);
         }
 
         //! Get the number of sources.
@@ -277,10 +267,10 @@ namespace hoa
     {
 
     private:
-        const size_t m_number_of_sources;
-        T*      m_values_old;
-        T*      m_values_new;
-        T*      m_values_step;
+        size_t       m_number_of_sources;
+        Buffer<T> m_values_old;
+        Buffer<T> m_values_new;
+        Buffer<T> m_values_step;
         size_t   m_counter;
         size_t   m_ramp;
 
@@ -292,19 +282,9 @@ namespace hoa
         PolarLines(size_t numberOfSources) hoa_noexcept :
         m_number_of_sources(numberOfSources)
         {
-            m_values_old    = Signal<T>::alloc(m_number_of_sources * 3);
-            m_values_new    = Signal<T>::alloc(m_number_of_sources * 3);
-            m_values_step   = Signal<T>::alloc(m_number_of_sources * 3);
-        }
-
-        //! The destructor.
-        /** The destructor free the memory.
-         */
-        ~PolarLines()
-        {
-            Signal<T>::free(m_values_old);
-            Signal<T>::free(m_values_new);
-            Signal<T>::free(m_values_step);
+            m_values_old.resize(m_number_of_sources * 3);
+            m_values_new.resize(m_number_of_sources * 3);
+            m_values_step.resize(m_number_of_sources * 3);
         }
 
         //! Get the number of sources.
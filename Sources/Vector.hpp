@@ -8,6 +8,7 @@
 #define DEF_HOA_VECTOR_LIGHT
 
 #include "Planewaves.hpp"
+#include "Snapshot.hpp"
 
 namespace hoa
 {
@@ -54,6 +55,21 @@ namespace hoa
          @param     outputs  The outputs array.
          */
         virtual void processEnergy(const T* inputs, T* outputs) hoa_noexcept = 0;
+
+        //! Set the size of the window of the block processing.
+        /** Set the number of samples over which the block processing averages the vectors.
+         @param     size   The number of samples of the window.
+         */
+        virtual void setWindowSize(const size_t size) hoa_noexcept = 0;
+
+        //! This method computes the time-averaged energy and velocity vectors.
+        /**	You should use this method to monitor a decoding from the digital signal processing. The velocity vector is the sum of the products of the channels with the pressure (the sum of the channels) normalized by the energy of the pressure, and the energy vector is the sum of the energies of the channels normalized by the total energy, both accumulated over the window. The inputs matrix contains the channels samples with one row per channel (channels × vector size). The outputs array has the same arrangement as for the process method and is only written when the window is complete.
+         @param     vectorsize  The vector size.
+         @param     inputs      The inputs matrix.
+         @param     outputs     The outputs array.
+         @return    true if the outputs have been updated, otherwise false.
+         */
+        virtual bool processBlock(const size_t vectorsize, const T* inputs, T* outputs) hoa_noexcept = 0;
     };
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -61,9 +77,21 @@ namespace hoa
     template <typename T> class Vector<Hoa2d, T> : public Processor<Hoa2d, T>::Planewaves
     {
     private:
-        T* m_channels_square;
-        T* m_channels_abscissa;
-        T* m_channels_ordinate;
+        static const size_t m_pressure_size = 256ul;
+
+        Buffer<T> m_channels_square;
+        Buffer<T> m_channels_abscissa;
+        Buffer<T> m_channels_ordinate;
+        Buffer<T> m_channels_velocity;
+        Buffer<T> m_channels_energy;
+        Buffer<T> m_pressure;
+        T         m_pressure_energy;
+        size_t    m_window;
+        size_t    m_count;
+#if (__cplusplus > 199711L)
+        size_t      m_time;
+        Snapshot<T> m_snapshot;
+#endif
     public:
 
         //! The vector constructor.
@@ -71,20 +99,20 @@ namespace hoa
          @param     numberOfChannels	The number of channels.
          */
         Vector(const size_t numberOfChannels) hoa_noexcept : Processor<Hoa2d, T>::Planewaves(numberOfChannels)
+#if (__cplusplus > 199711L)
+        , m_time(0)
+        , m_snapshot(4)
+#endif
         {
-            m_channels_square   = Signal<T>::alloc(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
-            m_channels_abscissa = Signal<T>::alloc(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
-            m_channels_ordinate = Signal<T>::alloc(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
-        }
-
-        //! The vector destructor.
-        /**	The vector destructor free the memory.
-         */
-        ~Vector() hoa_noexcept
-        {
-            Signal<T>::free(m_channels_square);
-            Signal<T>::free(m_channels_abscissa);
-            Signal<T>::free(m_channels_ordinate);
+            m_channels_square.resize(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
+            m_channels_abscissa.resize(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
+            m_channels_ordinate.resize(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
+            m_channels_velocity.resize(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
+            m_channels_energy.resize(Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves());
+            m_pressure.resize(m_pressure_size);
+            m_pressure_energy   = 0;
+            m_window            = 1024;
+            m_count             = 0;
         }
 
         //! This method pre-computes the necessary values to process.
@@ -108,8 +136,31 @@ namespace hoa
         {
             processVelocity(inputs, outputs);
             processEnergy(inputs, outputs+2);
+#if (__cplusplus > 199711L)
+            Signal<T>::copy(4, outputs, m_snapshot.write());
+            m_time++;
+#endif
         }
 
+#if (__cplusplus > 199711L)
+        //! Publish the last vectors.
+        /** Publish the vectors computed by the last call to the process method in the snapshot. The audio thread should call this method once per display period, for example at the end of each vector, the time of the publication is the number of samples processed.
+         */
+        inline void publish() hoa_noexcept
+        {
+            m_snapshot.publish(m_time);
+        }
+
+        //! Get the snapshot of the vectors.
+        /** Get the snapshot in which the publish method stores the vectors and in which the processBlock method publishes the vectors at the end of each window. A graphical interface or a monitoring thread should poll the snapshot instead of reading the outputs of the process method while the audio thread processes. A set of values has the same arrangement as the outputs of the process method.
+         @return The snapshot of the vectors.
+         */
+        inline Snapshot<T>& getSnapshot() hoa_noexcept
+        {
+            return m_snapshot;
+        }
+#endif
+
         //! This method computes the velocity vector.
         /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and contains the channels samples and the minimum size must be the number of channels. The outputs array contains the vectors cartesian coordinates and the minimum size must be 2. The coordinates arrangement in the outputs array is velocity abscissa and velocity ordinate.
          @param     inputs   The inputs array.
@@ -159,15 +210,138 @@ namespace hoa
                 outputs[0] = outputs[1] = 0.;
             }
         }
+
+        //! Set the size of the window of the block processing.
+        /** Set the number of samples over which the block processing averages the vectors. The current window is restarted.
+         @param     size   The number of samples of the window.
+         */
+        inline void setWindowSize(const size_t size) hoa_noexcept
+        {
+            m_window = size ? size : 1;
+            m_count = 0;
+        }
+
+        //! Get the size of the window of the block processing.
+        /** Get the number of samples over which the block processing averages the vectors.
+         @return    The number of samples of the window.
+         */
+        inline size_t getWindowSize() const hoa_noexcept
+        {
+            return m_window;
+        }
+
+        //! This method computes the time-averaged energy and velocity vectors.
+        /**	You should use this method to monitor a decoding from the digital signal processing. The velocity vector is the sum of the products of the channels with the pressure (the sum of the channels) normalized by the energy of the pressure, and the energy vector is the sum of the energies of the channels normalized by the total energy, both accumulated over the window. The pressure is computed in parts of at most 256 samples in a buffer allocated by the constructor and each channel is read only once per part to accumulate both its product with the pressure and its energy, the coordinates are only applied when the window is complete. The inputs matrix contains the channels samples with one row per channel (channels × vector size). The outputs array contains the vectors cartesian coordinates with the same arrangement as for the process method and is only written when the window is complete.
+         @param     vectorsize  The vector size.
+         @param     inputs      The inputs matrix.
+         @param     outputs     The outputs array.
+         @return    true if the outputs have been updated, otherwise false.
+         */
+        bool processBlock(const size_t vectorsize, const T* inputs, T* outputs) hoa_noexcept
+        {
+            const size_t nchannels = Processor<Hoa2d, T>::Planewaves::getNumberOfPlanewaves();
+            bool updated = false;
+            size_t offset = 0;
+            while(offset < vectorsize)
+            {
+                if(m_count == 0)
+                {
+                    Signal<T>::clear(nchannels, m_channels_velocity);
+                    Signal<T>::clear(nchannels, m_channels_energy);
+                    m_pressure_energy = 0;
+                }
+                size_t size = (vectorsize - offset < m_window - m_count) ? vectorsize - offset : m_window - m_count;
+                if(size > m_pressure_size)
+                {
+                    size = m_pressure_size;
+                }
+                Signal<T>::copy(size, inputs + offset, m_pressure);
+                for(size_t i = 1; i < nchannels; i++)
+                {
+                    Signal<T>::add(size, inputs + i * vectorsize + offset, m_pressure);
+                }
+                m_pressure_energy += Signal<T>::energy(size, m_pressure);
+                for(size_t i = 0; i < nchannels; i++)
+                {
+                    const T* input = inputs + i * vectorsize + offset;
+                    T velocity0 = 0, velocity1 = 0, energy0 = 0, energy1 = 0;
+                    size_t j = 0;
+                    for(; j + 1 < size; j += 2)
+                    {
+                        velocity0 += input[j] * m_pressure[j];
+                        velocity1 += input[j + 1] * m_pressure[j + 1];
+                        energy0 += input[j] * input[j];
+                        energy1 += input[j + 1] * input[j + 1];
+                    }
+                    if(j < size)
+                    {
+                        velocity0 += input[j] * m_pressure[j];
+                        energy0 += input[j] * input[j];
+                    }
+                    m_channels_velocity[i] += velocity0 + velocity1;
+                    m_channels_energy[i] += energy0 + energy1;
+                }
+                m_count += size;
+                offset  += size;
+#if (__cplusplus > 199711L)
+                m_time  += size;
+#endif
+                if(m_count == m_window)
+                {
+                    const T velocityAbscissa = Signal<T>::dot(nchannels, m_channels_velocity, m_channels_abscissa);
+                    const T velocityOrdinate = Signal<T>::dot(nchannels, m_channels_velocity, m_channels_ordinate);
+                    const T energyAbscissa = Signal<T>::dot(nchannels, m_channels_energy, m_channels_abscissa);
+                    const T energyOrdinate = Signal<T>::dot(nchannels, m_channels_energy, m_channels_ordinate);
+                    const T energySum = Signal<T>::sum(nchannels, m_channels_energy);
+                    if(m_pressure_energy)
+                    {
+                        outputs[0] = velocityAbscissa / m_pressure_energy;
+                        outputs[1] = velocityOrdinate / m_pressure_energy;
+                    }
+                    else
+                    {
+                        outputs[0] = outputs[1] = 0.;
+                    }
+                    if(energySum)
+                    {
+                        outputs[2] = energyAbscissa / energySum;
+                        outputs[3] = energyOrdinate / energySum;
+                    }
+                    else
+                    {
+                        outputs[2] = outputs[3] = 0.;
+                    }
+#if (__cplusplus > 199711L)
+                    Signal<T>::copy(4, outputs, m_snapshot.write());
+                    m_snapshot.publish(m_time);
+#endif
+                    m_count = 0;
+                    updated = true;
+                }
+            }
+            return updated;
+        }
     };
 
     template <typename T> class Vector<Hoa3d, T> : public Processor<Hoa3d, T>::Planewaves
     {
     private:
-        T* m_channels_square;
-        T* m_channels_abscissa;
-        T* m_channels_ordinate;
-        T* m_channels_height;
+        static const size_t m_pressure_size = 256ul;
+
+        Buffer<T> m_channels_square;
+        Buffer<T> m_channels_abscissa;
+        Buffer<T> m_channels_ordinate;
+        Buffer<T> m_channels_height;
+        Buffer<T> m_channels_velocity;
+        Buffer<T> m_channels_energy;
+        Buffer<T> m_pressure;
+        T         m_pressure_energy;
+        size_t    m_window;
+        size_t    m_count;
+#if (__cplusplus > 199711L)
+        size_t      m_time;
+        Snapshot<T> m_snapshot;
+#endif
     public:
 
         //! The vector constructor.
@@ -175,22 +349,21 @@ namespace hoa
          @param     numberOfChannels	The number of channels.
          */
         Vector(const size_t numberOfChannels) hoa_noexcept : Processor<Hoa3d, T>::Planewaves(numberOfChannels)
+#if (__cplusplus > 199711L)
+        , m_time(0)
+        , m_snapshot(6)
+#endif
         {
-            m_channels_square   = Signal<T>::alloc(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
-            m_channels_abscissa = Signal<T>::alloc(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
-            m_channels_ordinate = Signal<T>::alloc(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
-            m_channels_height   = Signal<T>::alloc(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
-        }
-
-        //! The vector destructor.
-        /**	The vector destructor free the memory.
-         */
-        ~Vector() hoa_noexcept
-        {
-            Signal<T>::free(m_channels_square);
-            Signal<T>::free(m_channels_abscissa);
-            Signal<T>::free(m_channels_ordinate);
-            Signal<T>::free(m_channels_height);
+            m_channels_square.resize(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
+            m_channels_abscissa.resize(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
+            m_channels_ordinate.resize(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
+            m_channels_height.resize(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
+            m_channels_velocity.resize(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
+            m_channels_energy.resize(Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves());
+            m_pressure.resize(m_pressure_size);
+            m_pressure_energy   = 0;
+            m_window            = 1024;
+            m_count             = 0;
         }
 
         //! This method pre-computes the necessary values to process.
@@ -215,8 +388,31 @@ namespace hoa
         {
             processVelocity(inputs, outputs);
             processEnergy(inputs, outputs+3);
+#if (__cplusplus > 199711L)
+            Signal<T>::copy(6, outputs, m_snapshot.write());
+            m_time++;
+#endif
         }
 
+#if (__cplusplus > 199711L)
+        //! Publish the last vectors.
+        /** Publish the vectors computed by the last call to the process method in the snapshot. The audio thread should call this method once per display period, for example at the end of each vector, the time of the publication is the number of samples processed.
+         */
+        inline void publish() hoa_noexcept
+        {
+            m_snapshot.publish(m_time);
+        }
+
+        //! Get the snapshot of the vectors.
+        /** Get the snapshot in which the publish method stores the vectors and in which the processBlock method publishes the vectors at the end of each window. A graphical interface or a monitoring thread should poll the snapshot instead of reading the outputs of the process method while the audio thread processes. A set of values has the same arrangement as the outputs of the process method.
+         @return The snapshot of the vectors.
+         */
+        inline Snapshot<T>& getSnapshot() hoa_noexcept
+        {
+            return m_snapshot;
+        }
+#endif
+
         //! This method compute the velocity vector.
         /**	You should use this method for in-place or not-in-place processing and sample by sample. The inputs array and contains the channels samples and the minimum size must be the number of channels. The outputs array contains the vectors cartesian coordinates and the minimum size must be 3. The coordinates arrangement in the outputs array is velocity abscissa, velocity ordinate and velocity height.
          @param     inputs   The inputs array.
@@ -271,6 +467,121 @@ namespace hoa
                     outputs[0] = outputs[1] = outputs[2] = 0.;
                 }
         }
+
+        //! Set the size of the window of the block processing.
+        /** Set the number of samples over which the block processing averages the vectors. The current window is restarted.
+         @param     size   The number of samples of the window.
+         */
+        inline void setWindowSize(const size_t size) hoa_noexcept
+        {
+            m_window = size ? size : 1;
+            m_count = 0;
+        }
+
+        //! Get the size of the window of the block processing.
+        /** Get the number of samples over which the block processing averages the vectors.
+         @return    The number of samples of the window.
+         */
+        inline size_t getWindowSize() const hoa_noexcept
+        {
+            return m_window;
+        }
+
+        //! This method computes the time-averaged energy and velocity vectors.
+        /**	You should use this method to monitor a decoding from the digital signal processing. The velocity vector is the sum of the products of the channels with the pressure (the sum of the channels) normalized by the energy of the pressure, and the energy vector is the sum of the energies of the channels normalized by the total energy, both accumulated over the window. The pressure is computed in parts of at most 256 samples in a buffer allocated by the constructor and each channel is read only once per part to accumulate both its product with the pressure and its energy, the coordinates are only applied when the window is complete. The inputs matrix contains the channels samples with one row per channel (channels × vector size). The outputs array contains the vectors cartesian coordinates with the same arrangement as for the process method and is only written when the window is complete.
+         @param     vectorsize  The vector size.
+         @param     inputs      The inputs matrix.
+         @param     outputs     The outputs array.
+         @return    true if the outputs have been updated, otherwise false.
+         */
+        bool processBlock(const size_t vectorsize, const T* inputs, T* outputs) hoa_noexcept
+        {
+            const size_t nchannels = Processor<Hoa3d, T>::Planewaves::getNumberOfPlanewaves();
+            bool updated = false;
+            size_t offset = 0;
+            while(offset < vectorsize)
+            {
+                if(m_count == 0)
+                {
+                    Signal<T>::clear(nchannels, m_channels_velocity);
+                    Signal<T>::clear(nchannels, m_channels_energy);
+                    m_pressure_energy = 0;
+                }
+                size_t size = (vectorsize - offset < m_window - m_count) ? vectorsize - offset : m_window - m_count;
+                if(size > m_pressure_size)
+                {
+                    size = m_pressure_size;
+                }
+                Signal<T>::copy(size, inputs + offset, m_pressure);
+                for(size_t i = 1; i < nchannels; i++)
+                {
+                    Signal<T>::add(size, inputs + i * vectorsize + offset, m_pressure);
+                }
+                m_pressure_energy += Signal<T>::energy(size, m_pressure);
+                for(size_t i = 0; i < nchannels; i++)
+                {
+                    const T* input = inputs + i * vectorsize + offset;
+                    T velocity0 = 0, velocity1 = 0, energy0 = 0, energy1 = 0;
+                    size_t j = 0;
+                    for(; j + 1 < size; j += 2)
+                    {
+                        velocity0 += input[j] * m_pressure[j];
+                        velocity1 += input[j + 1] * m_pressure[j + 1];
+                        energy0 += input[j] * input[j];
+                        energy1 += input[j + 1] * input[j + 1];
+                    }
+                    if(j < size)
+                    {
+                        velocity0 += input[j] * m_pressure[j];
+                        energy0 += input[j] * input[j];
+                    }
+                    m_channels_velocity[i] += velocity0 + velocity1;
+                    m_channels_energy[i] += energy0 + energy1;
+                }
+                m_count += size;
+                offset  += size;
+#if (__cplusplus > 199711L)
+                m_time  += size;
+#endif
+                if(m_count == m_window)
+                {
+                    const T velocityAbscissa = Signal<T>::dot(nchannels, m_channels_velocity, m_channels_abscissa);
+                    const T velocityOrdinate = Signal<T>::dot(nchannels, m_channels_velocity, m_channels_ordinate);
+                    const T velocityHeight = Signal<T>::dot(nchannels, m_channels_velocity, m_channels_height);
+                    const T energyAbscissa = Signal<T>::dot(nchannels, m_channels_energy, m_channels_abscissa);
+                    const T energyOrdinate = Signal<T>::dot(nchannels, m_channels_energy, m_channels_ordinate);
+                    const T energyHeight = Signal<T>::dot(nchannels, m_channels_energy, m_channels_height);
+                    const T energySum = Signal<T>::sum(nchannels, m_channels_energy);
+                    if(m_pressure_energy)
+                    {
+                        outputs[0] = velocityAbscissa / m_pressure_energy;
+                        outputs[1] = velocityOrdinate / m_pressure_energy;
+                        outputs[2] = velocityHeight / m_pressure_energy;
+                    }
+                    else
+                    {
+                        outputs[0] = outputs[1] = outputs[2] = 0.;
+                    }
+                    if(energySum)
+                    {
+                        outputs[3] = energyAbscissa / energySum;
+                        outputs[4] = energyOrdinate / energySum;
+                        outputs[5] = energyHeight / energySum;
+                    }
+                    else
+                    {
+                        outputs[3] = outputs[4] = outputs[5] = 0.;
+                    }
+#if (__cplusplus > 199711L)
+                    Signal<T>::copy(6, outputs, m_snapshot.write());
+                    m_snapshot.publish(m_time);
+#endif
+                    m_count = 0;
+                    updated = true;
+                }
+            }
+            return updated;
+        }
     };
 
 #endif
@@ -142,7 +142,7 @@ namespace hoa
 
             bool operator!=(Point const& other) const hoa_noexcept
             {
-                return fabs(other.x - x) > HOA_EPSILON && fabs(other.y - y) > HOA_EPSILON && fabs(other.z - z) > HOA_EPSILON;
+                return !(*this == other);
             }
 
             Point cross(Point const& other) const hoa_noexcept
@@ -344,12 +344,307 @@ namespace hoa
             }
         };
 
+        struct Face
+        {
+            size_t  v[3];
+            size_t  adj[3];
+            double  x;
+            double  y;
+            double  z;
+            double  w;
+            size_t  mark;
+            bool    alive;
+            std::vector<size_t> conflicts;
+        };
+
         static bool onBottom(Point const& p1) hoa_noexcept
         {
             return p1.z < 0.;
         }
 
         std::vector<Point>       m_points;
+        std::vector<Face>        m_faces;
+
+        inline double distance(Face const& f, Point const& p) const hoa_noexcept
+        {
+            return f.x * p.x + f.y * p.y + f.z * p.z - f.w;
+        }
+
+        size_t addFace(const size_t a, const size_t b, const size_t c)
+        {
+            Face f;
+            f.v[0] = a; f.v[1] = b; f.v[2] = c;
+            f.adj[0] = f.adj[1] = f.adj[2] = 0;
+            const Point n = (m_points[c] - m_points[a]).cross(m_points[b] - m_points[a]);
+            const double l = n.radius();
+            f.x = l > 0. ? n.x / l : 0.; f.y = l > 0. ? n.y / l : 0.; f.z = l > 0. ? n.z / l : 0.;
+            f.w = f.x * m_points[a].x + f.y * m_points[a].y + f.z * m_points[a].z;
+            f.mark  = 0;
+            f.alive = true;
+            m_faces.push_back(f);
+            return m_faces.size() - 1;
+        }
+
+        static size_t getGroup(std::vector<size_t>& groups, size_t i) hoa_noexcept
+        {
+            while(groups[i] != i)
+            {
+                groups[i] = groups[groups[i]];
+                i = groups[i];
+            }
+            return i;
+        }
+
+        //! Computes the convex hull of the points.
+        /** The points are inserted in a pseudo-random order in a tetrahedron, each point that is not inserted yet is attached to a face that sees it, so only the points of the removed faces are tested again after an insertion. The method fails if the points are degenerated or if a point is not a vertex of the hull (duplicated points).
+         */
+        bool computeHull()
+        {
+            const double epsilon = 1e-10;
+            const size_t size = m_points.size();
+            m_faces.clear();
+            if(size < 4)
+            {
+                return false;
+            }
+
+            // The initial tetrahedron
+            size_t i1 = 0, i2 = 0, i3 = 0;
+            double best = 0.;
+            for(size_t i = 1; i < size; i++)
+            {
+                const double d = m_points[i].length(m_points[0]);
+                if(d > best) { best = d; i1 = i; }
+            }
+            best = 0.;
+            const Point e1 = m_points[i1] - m_points[0];
+            for(size_t i = 1; i < size; i++)
+            {
+                const double d = e1.cross(m_points[i] - m_points[0]).radius();
+                if(d > best) { best = d; i2 = i; }
+            }
+            if(best < epsilon)
+            {
+                return false;
+            }
+            best = 0.;
+            const Point n = e1.cross(m_points[i2] - m_points[0]);
+            for(size_t i = 1; i < size; i++)
+            {
+                const double d = fabs(n.dot(m_points[i] - m_points[0]));
+                if(d > best) { best = d; i3 = i; }
+            }
+            if(best < epsilon)
+            {
+                return false;
+            }
+            if(n.dot(m_points[i3] - m_points[0]) < 0.)
+            {
+                std::swap(i1, i2);
+            }
+            addFace(0, i1, i2); addFace(0, i3, i1); addFace(i1, i3, i2); addFace(i2, i3, 0);
+            {
+                std::map<std::pair<size_t, size_t>, std::pair<size_t, size_t> > edges;
+                for(size_t i = 0; i < 4; i++)
+                {
+                    for(size_t k = 0; k < 3; k++)
+                    {
+                        edges[std::make_pair(m_faces[i].v[k], m_faces[i].v[(k+1)%3])] = std::make_pair(i, k);
+                    }
+                }
+                for(size_t i = 0; i < 4; i++)
+                {
+                    for(size_t k = 0; k < 3; k++)
+                    {
+                        m_faces[i].adj[k] = edges[std::make_pair(m_faces[i].v[(k+1)%3], m_faces[i].v[k])].first;
+                    }
+                }
+            }
+
+            // The insertion order and the conflicts
+            std::vector<size_t> order;
+            std::vector<size_t> conflict(size, size_t(-1));
+            std::vector<bool>   inserted(size, false);
+            inserted[0] = inserted[i1] = inserted[i2] = inserted[i3] = true;
+            size_t seed = 1;
+            for(size_t i = 0; i < size; i++)
+            {
+                if(!inserted[i])
+                {
+                    order.push_back(i);
+                }
+            }
+            for(size_t i = order.size(); i > 1; i--)
+            {
+                seed = (seed * 1103515245ul + 12345ul) & 0x7ffffffful;
+                std::swap(order[i-1], order[seed % i]);
+            }
+            for(size_t i = 0; i < order.size(); i++)
+            {
+                for(size_t j = 0; j < 4; j++)
+                {
+                    if(distance(m_faces[j], m_points[order[i]]) > epsilon)
+                    {
+                        conflict[order[i]] = j;
+                        m_faces[j].conflicts.push_back(order[i]);
+                        break;
+                    }
+                }
+            }
+
+            std::vector<size_t> visibles, stack, horizon, created, pending;
+            std::map<size_t, size_t> starts;
+            for(size_t o = 0; o < order.size(); o++)
+            {
+                const size_t p = order[o];
+                if(conflict[p] == size_t(-1))
+                {
+                    continue;
+                }
+                const size_t mark = o + 1;
+
+                // The faces seen by the point and the horizon
+                visibles.clear(); horizon.clear(); stack.clear();
+                stack.push_back(conflict[p]);
+                m_faces[conflict[p]].mark = mark;
+                while(!stack.empty())
+                {
+                    const size_t f = stack.back();
+                    stack.pop_back();
+                    visibles.push_back(f);
+                    for(size_t k = 0; k < 3; k++)
+                    {
+                        const size_t g = m_faces[f].adj[k];
+                        if(m_faces[g].mark != mark && distance(m_faces[g], m_points[p]) > epsilon)
+                        {
+                            m_faces[g].mark = mark;
+                            stack.push_back(g);
+                        }
+                        else if(m_faces[g].mark != mark)
+                        {
+                            horizon.push_back(f);
+                            horizon.push_back(k);
+                        }
+                    }
+                }
+
+                // The new faces from the horizon to the point
+                created.clear(); starts.clear();
+                for(size_t i = 0; i < horizon.size(); i += 2)
+                {
+                    const size_t f = horizon[i], k = horizon[i+1];
+                    const size_t a = m_faces[f].v[k], b = m_faces[f].v[(k+1)%3];
+                    const size_t g = m_faces[f].adj[k];
+                    const size_t nf = addFace(a, b, p);
+                    m_faces[nf].adj[0] = g;
+                    for(size_t j = 0; j < 3; j++)
+                    {
+                        if(m_faces[g].adj[j] == f)
+                        {
+                            m_faces[g].adj[j] = nf;
+                        }
+                    }
+                    starts[a] = nf;
+                    created.push_back(nf);
+                }
+                for(size_t i = 0; i < created.size(); i++)
+                {
+                    const size_t nf = created[i];
+                    const size_t next = starts[m_faces[nf].v[1]];
+                    m_faces[nf].adj[1] = next;
+                    m_faces[next].adj[2] = nf;
+                }
+
+                // The points of the removed faces are attached to the new faces
+                pending.clear();
+                for(size_t i = 0; i < visibles.size(); i++)
+                {
+                    Face& f = m_faces[visibles[i]];
+                    f.alive = false;
+                    pending.insert(pending.end(), f.conflicts.begin(), f.conflicts.end());
+                    std::vector<size_t>().swap(f.conflicts);
+                }
+                inserted[p] = true;
+                for(size_t i = 0; i < pending.size(); i++)
+                {
+                    const size_t q = pending[i];
+                    conflict[q] = size_t(-1);
+                    if(inserted[q])
+                    {
+                        continue;
+                    }
+                    for(size_t j = 0; j < created.size(); j++)
+                    {
+                        if(distance(m_faces[created[j]], m_points[q]) > epsilon)
+                        {
+                            conflict[q] = created[j];
+                            m_faces[created[j]].conflicts.push_back(q);
+                            break;
+                        }
+                    }
+                }
+            }
+
+            // The hull must contain all the points and the center of the sphere
+            for(size_t i = 0; i < size; i++)
+            {
+                if(!inserted[i])
+                {
+                    return false;
+                }
+            }
+            for(size_t i = 0; i < m_faces.size(); i++)
+            {
+                if(m_faces[i].alive && m_faces[i].w < HOA_EPSILON)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        //! Computes the diagram by testing every triangle against every point.
+        /** This method is only used when the convex hull fails, it is exact for any set of points but its complexity is O(n⁴).
+         */
+        void computeExhaustive()
+        {
+            for(size_t i = 0; i < m_points.size() - 2; i++)
+            {
+                for(size_t j = i+1; j < m_points.size() - 1; j++)
+                {
+                    for(size_t k = j+1; k < m_points.size(); k++)
+                    {
+                        Triangle t(m_points[i], m_points[j], m_points[k]);
+                        if(t.r > 0.)
+                        {
+                            bool valid = true;
+                            for(size_t l = 0; l < m_points.size(); l++)
+                            {
+                                if(l != i && l != j && l != k)
+                                {
+                                    if(t.p.length(m_points[l]) < t.r - HOA_EPSILON)
+                                    {
+                                        valid = false;
+                                    }
+                                }
+                            }
+                            if(valid)
+                            {
+                                m_points[i].addNeighbour(m_points[j]);
+                                m_points[i].addNeighbour(m_points[k]);
+                                m_points[i].addBound(t.p);
+                                m_points[j].addNeighbour(m_points[i]);
+                                m_points[j].addNeighbour(m_points[k]);
+                                m_points[j].addBound(t.p);
+                                m_points[k].addNeighbour(m_points[i]);
+                                m_points[k].addNeighbour(m_points[j]);
+                                m_points[k].addBound(t.p);
+                            }
+                        }
+                    }
+                }
+            }
+        }
     public:
 
         Voronoi() hoa_noexcept
@@ -402,52 +697,100 @@ namespace hoa
             return m_points[i].neightbours;
         }
 
-        void compute()
+        //! Computes the diagram.
+        /** The triangles of the diagram are the faces of the convex hull of the points, the bound of a triangle is the normal of its face. The faces whose points are on the same circle are merged, so all the points of a circle are neighbours like with an exhaustive search. The complexity is O(n log n) on average, if the points are degenerated the diagram is computed by testing every triangle against every point. A point is added at the bottom of the sphere if there is no point below the horizon. If the bounds are clipped, they are sorted around their point and only the part above the horizon is kept.
+         @param clip    If the bounds are clipped.
+         @return true if the points surround the center of the sphere, the diagram then doesn't depend on the orientation of the points, otherwise false.
+         */
+        bool compute(const bool clip = true)
         {
+            bool surround = true;
             if(find_if(m_points.begin(), m_points.end(), onBottom) == m_points.end())
             {
                 m_points.push_back(Point(0., 0., -1.));
+                surround = false;
             }
-            for(size_t i = 0; i < m_points.size() - 2; i++)
+            if(computeHull())
             {
-                for(size_t j = i+1; j < m_points.size() - 1; j++)
+                std::vector<size_t> groups(m_faces.size());
+                for(size_t i = 0; i < m_faces.size(); i++)
                 {
-                    for(size_t k = j+1; k < m_points.size(); k++)
+                    groups[i] = i;
+                }
+                for(size_t i = 0; i < m_faces.size(); i++)
+                {
+                    Face const& f = m_faces[i];
+                    if(!f.alive)
                     {
-                        Triangle t(m_points[i], m_points[j], m_points[k]);
-                        if(t.r > 0.)
+                        continue;
+                    }
+                    const Point center(f.x, f.y, f.z);
+                    const double radius = center.length(m_points[f.v[0]]);
+                    for(size_t k = 0; k < 3; k++)
+                    {
+                        Face const& g = m_faces[f.adj[k]];
+                        for(size_t j = 0; j < 3; j++)
                         {
-                            bool valid = true;
-                            for(size_t l = 0; l < m_points.size(); l++)
+                            const size_t v = g.v[j];
+                            if(v != f.v[0] && v != f.v[1] && v != f.v[2] && center.length(m_points[v]) < radius + HOA_EPSILON)
                             {
-                                if(l != i && l != j && l != k)
-                                {
-                                    if(t.p.length(m_points[l]) < t.r - HOA_EPSILON)
-                                    {
-                                        valid = false;
-                                    }
-                                }
+                                groups[getGroup(groups, f.adj[k])] = getGroup(groups, i);
                             }
-                            if(valid)
+                        }
+                    }
+                }
+                std::map<size_t, std::vector<size_t> > members;
+                for(size_t i = 0; i < m_faces.size(); i++)
+                {
+                    if(m_faces[i].alive)
+                    {
+                        members[getGroup(groups, i)].push_back(i);
+                    }
+                }
+                std::vector<size_t> vertices;
+                for(std::map<size_t, std::vector<size_t> >::const_iterator it = members.begin(); it != members.end(); ++it)
+                {
+                    vertices.clear();
+                    for(size_t i = 0; i < it->second.size(); i++)
+                    {
+                        Face const& f = m_faces[it->second[i]];
+                        vertices.insert(vertices.end(), f.v, f.v + 3);
+                    }
+                    std::sort(vertices.begin(), vertices.end());
+                    vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+                    for(size_t i = 0; i < vertices.size(); i++)
+                    {
+                        Point& point = m_points[vertices[i]];
+                        for(size_t j = 0; j < vertices.size(); j++)
+                        {
+                            if(j != i)
                             {
-                                m_points[i].addNeighbour(m_points[j]);
-                                m_points[i].addNeighbour(m_points[k]);
-                                m_points[i].addBound(t.p);
-                                m_points[j].addNeighbour(m_points[i]);
-                                m_points[j].addNeighbour(m_points[k]);
-                                m_points[j].addBound(t.p);
-                                m_points[k].addNeighbour(m_points[i]);
-                                m_points[k].addNeighbour(m_points[j]);
-                                m_points[k].addBound(t.p);
+                                point.addNeighbour(m_points[vertices[j]]);
                             }
                         }
+                        for(size_t j = 0; j < it->second.size(); j++)
+                        {
+                            Face const& f = m_faces[it->second[j]];
+                            point.addBound(Point(f.x, f.y, f.z));
+                        }
                     }
                 }
+                m_faces.clear();
+            }
+            else
+            {
+                m_faces.clear();
+                computeExhaustive();
+                surround = false;
             }
-            for(size_t i = 0; i < m_points.size(); i++)
+            if(clip)
             {
-                m_points[i].filterBounds();
+                for(size_t i = 0; i < m_points.size(); i++)
+                {
+                    m_points[i].filterBounds();
+                }
             }
+            return surround;
         }
     };
 
@@ -58,6 +58,14 @@ namespace hoa
          */
 		virtual void process(const T* inputs, T* outputs) hoa_noexcept = 0;
 
+        //! This method perform the widening of a block of samples.
+        /**	You should use this method for in-place or not-in-place processing of a block of samples. The inputs matrix and the outputs matrix contain the harmonics samples with one row per harmonic (harmonics × vector size). The gains are interpolated over the block from the widening of the previous block to the current widening, so the widening can change between two blocks without discontinuity. When the inputs are silent, the outputs are only cleared.
+         @param     vectorsize  The vector size.
+         @param     inputs      The inputs matrix.
+         @param     outputs     The outputs matrix.
+         */
+        virtual void processBlock(const size_t vectorsize, T const* inputs, T* outputs) hoa_noexcept = 0;
+
     };
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -65,26 +73,43 @@ namespace hoa
     template <typename T> class Wider<Hoa2d, T> : public Processor<Hoa2d, T>::Harmonics
     {
     private:
-        T   m_widening;
-        T   m_gain;
-        T   m_factor;
+        T           m_widening;
+        T           m_gain;
+        T           m_factor;
+        Buffer<T>   m_gains;
+        Buffer<T>   m_previous;
+
+        inline void computeGains() hoa_noexcept
+        {
+            const size_t order = Processor<Hoa2d, T>::Harmonics::getDecompositionOrder();
+            const T gain = (m_gain * order);
+            m_gains[0] = (gain + 1.);
+            const T factor = (cos(Math<T>::clip(m_factor, 0., HOA_PI)) + 1.) * 0.5 * ((gain - m_gain) + 1.);
+            for(size_t i = 1; i < Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics(); i++)
+            {
+                const size_t degree = Processor<Hoa2d, T>::Harmonics::getHarmonicDegree(i);
+                if(degree == 1)
+                {
+                    m_gains[i] = factor;
+                }
+                else
+                {
+                    m_gains[i] = (cos(Math<T>::clip(m_factor * degree, 0., HOA_PI)) + 1.) * 0.5 * (m_gain * (order - degree) + 1.);
+                }
+            }
+        }
     public:
 
         //! The wider constructor.
         /**	The wider constructor allocates and initialize the member values. The order must be at least 1.
          @param     order	The order.
          */
-        Wider(const size_t order) hoa_noexcept : Processor<Hoa2d, T>::Harmonics(order)
+        Wider(const size_t order) hoa_noexcept : Processor<Hoa2d, T>::Harmonics(order),
+        m_gains(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics()),
+        m_previous(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics())
         {
             setWidening(1.);
-        }
-
-        //! The wider destructor.
-        /**	The wider destructor free the memory.
-         */
-        ~Wider() hoa_noexcept
-        {
-            ;
+            Signal<T>::copy(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics(), m_gains, m_previous);
         }
 
         //! This method set the widening value.
@@ -97,6 +122,7 @@ namespace hoa
             m_widening  = Math<T>::clip(widening, (T)0., (T)1.);
             m_factor    = (1. - m_widening) * HOA_PI;
             m_gain      = (sin(m_factor - HOA_PI2) + 1.) * 0.5;
+            computeGains();
         }
 
         //! Get the the widening value.
@@ -115,46 +141,86 @@ namespace hoa
          */
         inline void process(const T* inputs, T* outputs) hoa_noexcept hoa_override
         {
-            T gain   = (m_gain * Processor<Hoa2d, T>::Harmonics::getDecompositionOrder());
-            T factor = (cos(Math<T>::clip(m_factor, 0., HOA_PI)) + 1.) * 0.5 * ((gain - m_gain) + 1.);
+            Signal<T>::mul(Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics(), inputs, m_gains, outputs);
+        }
 
-            (*outputs++) = (*inputs++) * (gain + 1.);            // Hamonic [0,0]
-            (*outputs++) = (*inputs++) * factor;                 // Hamonic [1,-1]
-            (*outputs++) = (*inputs++) * factor;                 // Hamonic [1,1]
-            for(size_t i = 2; i <= Processor<Hoa2d, T>::Harmonics::getDecompositionOrder(); i++)
+        //! This method perform the widening of a block of samples.
+        /**	You should use this method for in-place or not-in-place processing of a block of samples. The inputs matrix and the outputs matrix contain the harmonics samples with one row per harmonic (harmonics × vector size). The gains are interpolated over the block from the widening of the previous block to the current widening. When the inputs are silent, the outputs are only cleared.
+         @param     vectorsize  The vector size.
+         @param     inputs      The inputs matrix.
+         @param     outputs     The outputs matrix.
+         */
+        inline void processBlock(const size_t vectorsize, T const* inputs, T* outputs) hoa_noexcept
+        {
+            const size_t nharmonics = Processor<Hoa2d, T>::Harmonics::getNumberOfHarmonics();
+            if(Signal<T>::isZero(nharmonics * vectorsize, inputs))
             {
-                gain    = (m_gain * (Processor<Hoa2d, T>::Harmonics::getDecompositionOrder() - i) + 1.);
-                factor  = (cos(Math<T>::clip(m_factor * i, 0., HOA_PI)) + 1.) * 0.5 ;
-
-                (*outputs++)    = (*inputs++) * factor * gain;    // Hamonic [i,-i]
-                (*outputs++)    = (*inputs++) * factor * gain;    // Hamonic [i,i]
+                Signal<T>::clear(nharmonics * vectorsize, outputs);
+                Signal<T>::copy(nharmonics, m_gains, m_previous);
+                return;
             }
+            for(size_t i = 0; i < nharmonics; i++)
+            {
+                T const* in = inputs + i * vectorsize;
+                T* out      = outputs + i * vectorsize;
+                const T start = m_previous[i];
+                if(start == m_gains[i])
+                {
+                    Signal<T>::scale(vectorsize, start, in, out);
+                }
+                else
+                {
+                    const T step = (m_gains[i] - start) / T(vectorsize);
+                    for(size_t j = 0; j < vectorsize; j++)
+                    {
+                        out[j] = in[j] * (start + step * T(j + 1));
+                    }
+                }
+            }
+            Signal<T>::copy(nharmonics, m_gains, m_previous);
         }
     };
 
     template <typename T> class Wider<Hoa3d, T> : public Processor<Hoa3d, T>::Harmonics
     {
     private:
-        T   m_widening;
-        T   m_gain;
-        T   m_factor;
+        T           m_widening;
+        T           m_gain;
+        T           m_factor;
+        Buffer<T>   m_gains;
+        Buffer<T>   m_previous;
+
+        inline void computeGains() hoa_noexcept
+        {
+            const size_t order = Processor<Hoa3d, T>::Harmonics::getDecompositionOrder();
+            const T gain = (m_gain * order);
+            m_gains[0] = (gain + 1.);
+            const T factor = (cos(Math<T>::clip(m_factor, 0., HOA_PI)) + 1.) * 0.5 * ((gain - m_gain) + 1.);
+            for(size_t i = 1; i < Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics(); i++)
+            {
+                const size_t degree = Processor<Hoa3d, T>::Harmonics::getHarmonicDegree(i);
+                if(degree == 1)
+                {
+                    m_gains[i] = factor;
+                }
+                else
+                {
+                    m_gains[i] = (cos(Math<T>::clip(m_factor * degree, 0., HOA_PI)) + 1.) * 0.5 * (m_gain * (order - degree) + 1.);
+                }
+            }
+        }
     public:
 
         //! The wider constructor.
         /**	The wider constructor allocates and initialize the member values. The order must be at least 1.
          @param     order	The order.
          */
-        Wider(const size_t order) hoa_noexcept : Processor<Hoa3d, T>::Harmonics(order)
+        Wider(const size_t order) hoa_noexcept : Processor<Hoa3d, T>::Harmonics(order),
+        m_gains(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics()),
+        m_previous(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics())
         {
             setWidening(1.);
-        }
-
-        //! The wider destructor.
-        /**	The wider destructor free the memory.
-         */
-        ~Wider() hoa_noexcept
-        {
-            ;
+            Signal<T>::copy(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics(), m_gains, m_previous);
         }
 
         //! This method set the widening value.
@@ -167,6 +233,7 @@ namespace hoa
             m_widening  = Math<T>::clip(radius, (T)0., (T)1.);
             m_factor    = (1. - m_widening) * HOA_PI;
             m_gain      = (sin(m_factor - HOA_PI2) + 1.) * 0.5;
+            computeGains();
         }
 
         //! Get the the widening value.
@@ -185,23 +252,43 @@ namespace hoa
          */
         inline void process(const T* inputs, T* outputs) hoa_noexcept hoa_override
         {
-            T gain   = (m_gain * Processor<Hoa3d, T>::Harmonics::getDecompositionOrder());
-            T factor = (cos(Math<T>::clip(m_factor, 0., HOA_PI)) + 1.) * 0.5 * ((gain - m_gain) + 1.);
-
-            (*outputs++) = (*inputs++) * (gain + 1.);            // Hamonic [0,0]
-            (*outputs++) = (*inputs++) * factor;                 // Hamonic [1,-1]
-            (*outputs++) = (*inputs++) * factor;                 // Hamonic [1,0]
-            (*outputs++) = (*inputs++) * factor;                 // Hamonic [1,1]
-            for(size_t i = 2; i <= Processor<Hoa3d, T>::Harmonics::getDecompositionOrder(); i++)
-            {
-                gain    = (m_gain * (Processor<Hoa3d, T>::Harmonics::getDecompositionOrder() - i) + 1.);
-                factor  = (cos(Math<T>::clip(m_factor * i, 0., HOA_PI)) + 1.) * 0.5 ;
+            Signal<T>::mul(Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics(), inputs, m_gains, outputs);
+        }
 
-                for(size_t j = 0; j < 2 * i + 1; j++)
+        //! This method perform the widening of a block of samples.
+        /**	You should use this method for in-place or not-in-place processing of a block of samples. The inputs matrix and the outputs matrix contain the harmonics samples with one row per harmonic (harmonics × vector size). The gains are interpolated over the block from the widening of the previous block to the current widening. When the inputs are silent, the outputs are only cleared.
+         @param     vectorsize  The vector size.
+         @param     inputs      The inputs matrix.
+         @param     outputs     The outputs matrix.
+         */
+        inline void processBlock(const size_t vectorsize, T const* inputs, T* outputs) hoa_noexcept
+        {
+            const size_t nharmonics = Processor<Hoa3d, T>::Harmonics::getNumberOfHarmonics();
+            if(Signal<T>::isZero(nharmonics * vectorsize, inputs))
+            {
+                Signal<T>::clear(nharmonics * vectorsize, outputs);
+                Signal<T>::copy(nharmonics, m_gains, m_previous);
+                return;
+            }
+            for(size_t i = 0; i < nharmonics; i++)
+            {
+                T const* in = inputs + i * vectorsize;
+                T* out      = outputs + i * vectorsize;
+                const T start = m_previous[i];
+                if(start == m_gains[i])
+                {
+                    Signal<T>::scale(vectorsize, start, in, out);
+                }
+                else
                 {
-                    (*outputs++)    = (*inputs++) * factor * gain;    // Hamonic [i, ~j]
+                    const T step = (m_gains[i] - start) / T(vectorsize);
+                    for(size_t j = 0; j < vectorsize; j++)
+                    {
+                        out[j] = in[j] * (start + step * T(j + 1));
+                    }
                 }
             }
+            Signal<T>::copy(nharmonics, m_gains, m_previous);
         }
     };
 
@@ -0,0 +1,278 @@
+/*
+// Copyright (c) 2012-2015 Pierre Guillot, Eliott Paris & Thomas Le Meur CICM, Universite Paris 8.
+// For information on usage and redistribution, and for a DISCLAIMER OF ALL
+// WARRANTIES, see the file, "LICENSE.txt," in this distribution.
+*/
+
+#ifndef DEF_HOA_WORKERS_LIGHT
+#define DEF_HOA_WORKERS_LIGHT
+
+#include "Signal.hpp"
+
+#if (__cplusplus > 199711L)
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+namespace hoa
+{
+    //! The barrier class synchronizes a fixed number of threads.
+    /** The barrier blocks the threads that call the wait method until all the threads have called it, then it releases them all and it can be used again. A waiting thread first yields for a short time so a barrier reached once per block releases the threads without a system call, then it sleeps until the last thread arrives so the idle threads don't keep the processors busy.
+     */
+    class Barrier
+    {
+    private:
+        static const size_t     m_spins = 1024ul;
+
+        const size_t            m_size;
+        std::atomic<size_t>     m_count;
+        std::atomic<size_t>     m_generation;
+        std::atomic<size_t>     m_sleepers;
+        std::mutex              m_mutex;
+        std::condition_variable m_condition;
+
+        Barrier(const Barrier& other);
+        Barrier& operator=(const Barrier& other);
+
+    public:
+
+        //! The barrier constructor.
+        /**	The barrier constructor initializes the barrier for a number of threads.
+         @param     size    The number of threads, at least 1.
+         */
+        Barrier(const size_t size) hoa_noexcept :
+        m_size(size ? size : 1ul),
+        m_count(0ul),
+        m_generation(0ul),
+        m_sleepers(0ul)
+        {
+            ;
+        }
+
+        //! Retrieve the number of threads.
+        /** Retrieve the number of threads synchronized by the barrier.
+         @return The number of threads.
+         */
+        inline size_t getSize() const hoa_noexcept
+        {
+            return m_size;
+        }
+
+        //! Wait for the other threads.
+        /** Block until all the threads have called this method. The memory written by a thread before the call is visible to all the threads after the call.
+         */
+        void wait()
+        {
+            const size_t generation = m_generation.load(std::memory_order_acquire);
+            if(m_count.fetch_add(1ul, std::memory_order_acq_rel) + 1ul == m_size)
+            {
+                m_count.store(0ul, std::memory_order_relaxed);
+                m_generation.store(generation + 1ul, std::memory_order_seq_cst);
+                if(m_sleepers.load(std::memory_order_seq_cst))
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_condition.notify_all();
+                }
+                return;
+            }
+            for(size_t i = 0; i < m_spins; i++)
+            {
+                if(m_generation.load(std::memory_order_acquire) != generation)
+                {
+                    return;
+                }
+                std::this_thread::yield();
+            }
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_sleepers.fetch_add(1ul, std::memory_order_seq_cst);
+            while(m_generation.load(std::memory_order_seq_cst) == generation)
+            {
+                m_condition.wait(lock);
+            }
+            m_sleepers.fetch_sub(1ul, std::memory_order_relaxed);
+        }
+    };
+
+    //! The workers class shares the channels of a block processing between several threads.
+    /** The workers should be used to decode a sound field for a large number of loudspeakers. The workers own a pool of threads that wait for the blocks, each block is split in ranges of channels that are processed at the same time by the threads and by the caller, then a barrier ends the block so the outputs are complete when the processBlock method returns. The ranges start on a cache line of the outputs matrix when it is possible, so the threads never write in the same line. The workers must be used by only one thread at a time, usually the audio thread.
+     */
+    class Workers
+    {
+    private:
+        static const size_t      m_cache_line = 64ul;
+
+        std::vector<std::thread> m_threads;
+        Barrier                  m_start;
+        Barrier                  m_end;
+        std::atomic<bool>        m_running;
+        void                   (*m_function)(const void* job, const size_t first, const size_t count);
+        const void*              m_job;
+        size_t                   m_number_of_rows;
+        size_t                   m_granularity;
+
+        Workers(const Workers& other);
+        Workers& operator=(const Workers& other);
+
+        template <class P, typename T> struct Batch
+        {
+            P*       processor;
+            size_t   nscenes;
+            size_t   vectorsize;
+            const T* inputs;
+            T*       outputs;
+
+            static void run(const void* job, const size_t first, const size_t count) hoa_noexcept
+            {
+                const Batch* batch = static_cast<const Batch*>(job);
+                batch->processor->processBlock(batch->nscenes, batch->vectorsize, batch->inputs, batch->outputs, first, count);
+            }
+        };
+
+        template <class P, typename T> struct Block
+        {
+            P*       processor;
+            size_t   vectorsize;
+            const T* inputs;
+            T*       outputs;
+
+            static void run(const void* job, const size_t first, const size_t count) hoa_noexcept
+            {
+                const Block* block = static_cast<const Block*>(job);
+                block->processor->processBlock(block->vectorsize, block->inputs, block->outputs, first, count);
+            }
+        };
+
+        //! Processes the range of a thread.
+        /** The rows are grouped by the granularity and the groups are shared between the threads.
+         */
+        inline void execute(const size_t index) hoa_noexcept
+        {
+            const size_t nthreads = m_threads.size() + 1ul;
+            const size_t ngroups  = (m_number_of_rows + m_granularity - 1ul) / m_granularity;
+            const size_t first    = std::min(((index * ngroups) / nthreads) * m_granularity, m_number_of_rows);
+            const size_t last     = std::min((((index + 1ul) * ngroups) / nthreads) * m_granularity, m_number_of_rows);
+            if(last > first)
+            {
+                m_function(m_job, first, last - first);
+            }
+        }
+
+        void run(const size_t index)
+        {
+            for(;;)
+            {
+                m_start.wait();
+                if(!m_running.load(std::memory_order_acquire))
+                {
+                    return;
+                }
+                execute(index);
+                m_end.wait();
+            }
+        }
+
+        //! Processes a block.
+        /** Computes the granularity so each range starts on a cache line, then shares the rows between the threads.
+         */
+        void dispatch(void (*function)(const void*, const size_t, const size_t), const void* job, const size_t nrows, const size_t rowsize)
+        {
+            m_function       = function;
+            m_job            = job;
+            m_number_of_rows = nrows;
+            m_granularity    = 1ul;
+            while(m_granularity < m_cache_line && (m_granularity * rowsize) % m_cache_line)
+            {
+                m_granularity++;
+            }
+            m_start.wait();
+            execute(0ul);
+            m_end.wait();
+        }
+
+    public:
+
+        //! The workers constructor.
+        /**	The workers constructor starts the threads. The caller of the processBlock method is also used to process the blocks, so the number of threads started is the number of threads minus one.
+         @param     numberOfThreads    The number of threads that share a block, at least 1.
+         */
+        Workers(const size_t numberOfThreads) :
+        m_start(numberOfThreads),
+        m_end(numberOfThreads),
+        m_running(true),
+        m_function(hoa_nullptr),
+        m_job(hoa_nullptr),
+        m_number_of_rows(0ul),
+        m_granularity(1ul)
+        {
+            for(size_t i = 1; i < m_start.getSize(); i++)
+            {
+                m_threads.push_back(std::thread(&Workers::run, this, i));
+            }
+        }
+
+        //! The workers destructor.
+        /**	The workers destructor stops and joins the threads.
+         */
+        ~Workers()
+        {
+            m_running.store(false, std::memory_order_release);
+            m_start.wait();
+            for(size_t i = 0; i < m_threads.size(); i++)
+            {
+                m_threads[i].join();
+            }
+        }
+
+        //! Retrieve the number of threads.
+        /** Retrieve the number of threads that share a block, including the caller of the processBlock method.
+         @return The number of threads.
+         */
+        inline size_t getNumberOfThreads() const hoa_noexcept
+        {
+            return m_threads.size() + 1ul;
+        }
+
+        //! This method performs the decoding of several sound fields with the threads.
+        /**	You should use this method instead of the processBlock method of a regular or an irregular decoder. The silent inputs are tested once and bypassed for the whole block, otherwise the channels are shared between the threads. The layout of the matrices is the same as for the batched decoding.
+         @param     decoder     The decoder.
+         @param     nscenes     The number of scenes.
+         @param     vectorsize  The vector size of each scene.
+         @param     inputs      The input matrix that contains the samples of the harmonics.
+         @param     outputs     The output matrix that contains samples destinated to channels.
+         */
+        template <class P, typename T> void processBlock(P& decoder, const size_t nscenes, const size_t vectorsize, const T* inputs, T* outputs)
+        {
+            const size_t nrows = decoder.getNumberOfPlanewaves();
+            if(Signal<T>::isZero(decoder.getNumberOfHarmonics() * nscenes * vectorsize, inputs))
+            {
+                Signal<T>::clear(nrows * nscenes * vectorsize, outputs);
+                return;
+            }
+            const Batch<P, T> batch = {&decoder, nscenes, vectorsize, inputs, outputs};
+            dispatch(&Batch<P, T>::run, &batch, nrows, nscenes * vectorsize * sizeof(T));
+        }
+
+        //! This method performs the projection of a block of samples with the threads.
+        /**	You should use this method instead of the processBlock method of a projector. The silent inputs are tested once and bypassed for the whole block, otherwise the channels are shared between the threads.
+         @param     projector   The projector.
+         @param     vectorsize  The vector size.
+         @param     inputs      The input matrix that contains the samples of the harmonics.
+         @param     outputs     The output matrix that contains samples destinated to channels.
+         */
+        template <class P, typename T> void processBlock(P& projector, const size_t vectorsize, const T* inputs, T* outputs)
+        {
+            const size_t nrows = projector.getNumberOfPlanewaves();
+            if(Signal<T>::isZero(projector.getNumberOfHarmonics() * vectorsize, inputs))
+            {
+                Signal<T>::clear(nrows * vectorsize, outputs);
+                return;
+            }
+            const Block<P, T> block = {&projector, vectorsize, inputs, outputs};
+            dispatch(&Block<P, T>::run, &block, nrows, vectorsize * sizeof(T));
+        }
+    };
+}
+
+#endif
+#endif
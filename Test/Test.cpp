@@ -9,6 +9,11 @@
 #include <cstdlib>
 #include <ctime>
 #include <cassert>
+#include <vector>
+#if (__cplusplus > 199711L)
+#include <atomic>
+#include <thread>
+#endif
 
 static void test_binaural()
 {
@@ -49,7 +54,7 @@ static void test_binaural()
         {
             for(unsigned k = 0; k < i_blck_size; ++k)
             {
-                in_buf[j][i] = p_src[(i + k) * i_input_nb + j];
+                in_buf[j][k] = p_src[(i + k) * i_input_nb + j];
             }
         }
 
@@ -89,11 +94,1770 @@ static void test_binaural()
 }
 
 
+static void test_decoder_batch()
+{
+    const unsigned i_order      = 3;
+    const unsigned i_output_nb  = 9;
+    const unsigned i_scenes_nb  = 3;
+    const unsigned i_blck_size  = 13;
+    const unsigned i_cols       = i_scenes_nb * i_blck_size;
+
+    hoa::Decoder<hoa::Hoa2d, float>::Regular decoder(i_order, i_output_nb);
+    const unsigned i_input_nb = decoder.getNumberOfHarmonics();
+    float *p_src    = (float *)malloc(i_input_nb * i_cols * sizeof(float));
+    float *p_dest   = (float *)malloc(i_output_nb * i_cols * sizeof(float));
+    float frame_in[7];
+    float frame_out[9];
+    for(unsigned i = 0; i < i_input_nb * i_cols; ++i)
+    {
+        p_src[i] = float(rand()) / float(RAND_MAX) * 2.f - 1.f;
+    }
+
+    decoder.processBlock(i_scenes_nb, i_blck_size, p_src, p_dest);
+
+    float *p_split  = (float *)malloc(i_output_nb * i_cols * sizeof(float));
+    decoder.processBlock(i_scenes_nb, i_blck_size, p_src, p_split, 0, 4);
+    decoder.processBlock(i_scenes_nb, i_blck_size, p_src, p_split, 4, i_output_nb - 4);
+    for(unsigned i = 0; i < i_output_nb * i_cols; ++i)
+    {
+        assert(p_split[i] == p_dest[i] && "split mismatch");
+    }
+    free(p_split);
+
+    for(unsigned i = 0; i < i_cols; ++i)
+    {
+        for(unsigned j = 0; j < i_input_nb; ++j)
+        {
+            frame_in[j] = p_src[j * i_cols + i];
+        }
+        decoder.process(frame_in, frame_out);
+        for(unsigned j = 0; j < i_output_nb; ++j)
+        {
+            assert(fabs(frame_out[j] - p_dest[j * i_cols + i]) < 1e-5f && "batch mismatch");
+        }
+    }
+
+    free(p_src);
+    free(p_dest);
+}
+
+#if (__cplusplus > 199711L)
+static void test_decoder_workers()
+{
+    const unsigned i_order      = 3;
+    const unsigned i_output_nb  = 50;
+    const unsigned i_scenes_nb  = 2;
+    const unsigned i_blck_size  = 13;
+    const unsigned i_cols       = i_scenes_nb * i_blck_size;
+
+    hoa::Decoder<hoa::Hoa3d, float>::Regular decoder(i_order, i_output_nb);
+    hoa::Projector<hoa::Hoa2d, float> projector(i_order, i_output_nb);
+    decoder.computeRendering();
+    const unsigned i_input_nb = decoder.getNumberOfHarmonics();
+    std::vector<float> inputs(i_input_nb * i_cols), expected(i_output_nb * i_cols), outputs(i_output_nb * i_cols);
+
+    for(unsigned nthreads = 1; nthreads <= 4; ++nthreads)
+    {
+        hoa::Workers workers(nthreads);
+        assert(workers.getNumberOfThreads() == nthreads && "workers number of threads");
+        for(unsigned n = 0; n < 16; ++n)
+        {
+            const bool silent = (n % 5 == 4);
+            for(unsigned i = 0; i < i_input_nb * i_cols; ++i)
+            {
+                inputs[i] = silent ? 0.f : float(rand()) / float(RAND_MAX) * 2.f - 1.f;
+            }
+            std::fill(outputs.begin(), outputs.end(), 1.f);
+            decoder.processBlock(i_scenes_nb, i_blck_size, &inputs[0], &expected[0]);
+            workers.processBlock(decoder, i_scenes_nb, i_blck_size, &inputs[0], &outputs[0]);
+            for(unsigned i = 0; i < i_output_nb * i_cols; ++i)
+            {
+                assert(outputs[i] == expected[i] && "workers decoder mismatch");
+            }
+
+            std::fill(outputs.begin(), outputs.end(), 1.f);
+            projector.processBlock(i_blck_size, &inputs[0], &expected[0]);
+            workers.processBlock(projector, i_blck_size, &inputs[0], &outputs[0]);
+            for(unsigned i = 0; i < i_output_nb * i_blck_size; ++i)
+            {
+                assert(outputs[i] == expected[i] && "workers projector mismatch");
+            }
+        }
+    }
+}
+#endif
+
+#if (__cplusplus > 199711L)
+static void test_ring_copy()
+{
+    const unsigned i_channels = 3;
+    const unsigned i_vsize    = 5;
+
+    double samples[i_channels][i_vsize];
+    double results[i_channels][i_vsize];
+    double* inputs[i_channels];
+    double* outputs[i_channels];
+    for(unsigned i = 0; i < i_channels; ++i)
+    {
+        inputs[i]  = samples[i];
+        outputs[i] = results[i];
+    }
+
+    hoa::Ring<double> undelayed(i_channels, i_vsize, 2, false);
+    assert(undelayed.getLatency() == 0 && "ring undelayed latency");
+    assert(undelayed.getNumberOfBlocks() == 0 && "ring undelayed empty");
+    assert(!undelayed.pop(outputs) && "ring pop when empty");
+    for(unsigned n = 0; n < 2; ++n)
+    {
+        for(unsigned i = 0; i < i_channels; ++i)
+        {
+            for(unsigned k = 0; k < i_vsize; ++k)
+            {
+                samples[i][k] = double(n * 100 + i * 10 + k);
+            }
+        }
+        assert(undelayed.push(inputs) && "ring push");
+    }
+    assert(undelayed.getNumberOfBlocks() == 2 && "ring full");
+    assert(!undelayed.push(inputs) && "ring push when full");
+    for(unsigned n = 0; n < 2; ++n)
+    {
+        assert(undelayed.pop(outputs) && "ring pop");
+        for(unsigned i = 0; i < i_channels; ++i)
+        {
+            for(unsigned k = 0; k < i_vsize; ++k)
+            {
+                assert(results[i][k] == double(n * 100 + i * 10 + k) && "ring block order");
+            }
+        }
+    }
+    assert(!undelayed.pop(outputs) && "ring pop when emptied");
+
+    hoa::Ring<double> delayed(i_channels, i_vsize, 2, true);
+    assert(delayed.getLatency() == i_vsize && "ring delayed latency");
+    assert(delayed.getNumberOfBlocks() == 1 && "ring delayed block");
+    assert(delayed.push(inputs) && "ring delayed push");
+    assert(!delayed.push(inputs) && "ring delayed full");
+    assert(delayed.pop(outputs) && "ring delayed pop");
+    for(unsigned i = 0; i < i_channels; ++i)
+    {
+        for(unsigned k = 0; k < i_vsize; ++k)
+        {
+            assert(results[i][k] == 0. && "ring delayed silence");
+        }
+    }
+    assert(delayed.pop(outputs) && "ring delayed pop pushed");
+    assert(results[2][4] == samples[2][4] && "ring delayed block");
+    assert(!delayed.pop(outputs) && "ring delayed empty");
+}
+
+static void test_ring_inplace()
+{
+    const unsigned i_channels = 2;
+    const unsigned i_vsize    = 7;
+
+    hoa::Ring<float> ring(i_channels, i_vsize, 3, true);
+    assert(ring.getLatency() == i_vsize && "ring in place latency");
+    for(unsigned n = 0; n < 2; ++n)
+    {
+        float* const* block = ring.reserve();
+        assert(block && "ring reserve");
+        for(unsigned i = 0; i < i_channels; ++i)
+        {
+            for(unsigned k = 0; k < i_vsize; ++k)
+            {
+                block[i][k] = float(n * 100 + i * 10 + k + 1);
+            }
+        }
+        // the channels of a block are contiguous
+        assert(block[1] == block[0] + i_vsize && "ring reserve matrix");
+        assert(ring.getNumberOfBlocks() == n + 1 && "ring reserve before commit");
+        ring.commit();
+    }
+    assert(!ring.reserve() && "ring reserve when full");
+
+    const float* const* silence = ring.acquire();
+    assert(silence && silence[0][0] == 0.f && silence[1][i_vsize - 1] == 0.f && "ring acquire silence");
+    assert(ring.acquire() == silence && "ring acquire before release");
+    ring.release();
+    assert(ring.reserve() && "ring reserve after release");
+    for(unsigned n = 0; n < 2; ++n)
+    {
+        const float* const* block = ring.acquire();
+        assert(block && "ring acquire");
+        for(unsigned i = 0; i < i_channels; ++i)
+        {
+            for(unsigned k = 0; k < i_vsize; ++k)
+            {
+                assert(block[i][k] == float(n * 100 + i * 10 + k + 1) && "ring acquire order");
+            }
+        }
+        ring.release();
+    }
+    assert(!ring.acquire() && "ring acquire when empty");
+    assert(ring.getNumberOfBlocks() == 0 && "ring in place empty");
+
+    // a delayed ring keeps a slot for the producer besides the block of silence
+    hoa::Ring<float> small(i_channels, i_vsize, 1, true);
+    assert(small.getNumberOfSlots() == 2 && "ring delayed minimum slots");
+    assert(small.reserve() && "ring delayed reserve");
+    hoa::Ring<float> single(i_channels, i_vsize, 0, false);
+    assert(single.getNumberOfSlots() == 1 && "ring minimum slots");
+    assert(single.reserve() && "ring single reserve");
+    single.commit();
+    assert(!single.reserve() && single.acquire() && "ring single full");
+}
+#endif
+
+#if (__cplusplus > 199711L)
+static void test_pool()
+{
+    const unsigned i_objects = 3;
+    hoa::Encoder<hoa::Hoa2d, double>::Basic prototype(3);
+    prototype.setAzimuth(0.5);
+    hoa::Pool< hoa::Encoder<hoa::Hoa2d, double>::Basic > pool(prototype, i_objects);
+    assert(pool.getNumberOfObjects() == i_objects && "pool size");
+    assert(pool.getPrototype().getAzimuth() == 0.5 && "pool prototype");
+
+    std::vector< hoa::Encoder<hoa::Hoa2d, double>::Basic* > objects;
+    for(unsigned i = 0; i < i_objects; ++i)
+    {
+        objects.push_back(pool.acquire());
+        assert(objects.back() && "pool acquire");
+        assert(objects.back()->getAzimuth() == 0.5 && "pool acquire prototype state");
+        for(unsigned j = 0; j < i; ++j)
+        {
+            assert(objects[j] != objects[i] && "pool acquire distinct");
+        }
+        objects.back()->setAzimuth(double(i + 1));
+    }
+    assert(!pool.acquire() && "pool exhausted");
+
+    pool.release(objects[1]);
+    hoa::Encoder<hoa::Hoa2d, double>::Basic* object = pool.acquire();
+    assert(object == objects[1] && "pool release then acquire");
+    assert(!pool.acquire() && "pool exhausted again");
+
+    // a released processor is reset to the state of the prototype
+    assert(object->getAzimuth() == 0.5 && "pool release reset");
+    std::vector<double> harmonics(object->getNumberOfHarmonics()), expected(object->getNumberOfHarmonics());
+    const double input = 1.;
+    object->process(&input, &harmonics[0]);
+    prototype.process(&input, &expected[0]);
+    for(unsigned i = 0; i < harmonics.size(); ++i)
+    {
+        assert(harmonics[i] == expected[i] && "pool release reset process");
+    }
+    assert(objects[0]->getAzimuth() == 1. && objects[2]->getAzimuth() == 3. && "pool others untouched");
+}
+#endif
+
+static void test_containers()
+{
+    const unsigned i_order      = 3;
+    const unsigned i_output_nb  = 8;
+    const unsigned i_sources_nb = 2;
+
+    std::vector< hoa::Decoder<hoa::Hoa2d, float>::Regular > decoders;
+    std::vector< hoa::Encoder<hoa::Hoa2d, float>::Multi > encoders;
+    for(unsigned i = 0; i < 4; ++i)
+    {
+        decoders.push_back(hoa::Decoder<hoa::Hoa2d, float>::Regular(i_order, i_output_nb));
+        encoders.push_back(hoa::Encoder<hoa::Hoa2d, float>::Multi(i_order, i_sources_nb));
+        encoders[i].setAzimuth(0, float(i));
+        encoders[i].setRadius(1, 2.f);
+    }
+    encoders.erase(encoders.begin());
+    decoders.erase(decoders.begin());
+
+    const hoa::Encoder<hoa::Hoa2d, float>::Multi copy(encoders.back());
+    float sources[2] = {1.f, 0.5f};
+    float harmonics[7];
+    float channels[8];
+    float expected[8];
+    hoa::Encoder<hoa::Hoa2d, float>::Multi encoder(i_order, i_sources_nb);
+    hoa::Decoder<hoa::Hoa2d, float>::Regular decoder(i_order, i_output_nb);
+    encoder.setAzimuth(0, 3.f);
+    encoder.setRadius(1, 2.f);
+    encoder.process(sources, harmonics);
+    decoder.process(harmonics, expected);
+    assert(copy.getAzimuth(0) == 3.f && "copy mismatch");
+
+    encoders.back().process(sources, harmonics);
+    decoders.back().process(harmonics, channels);
+    for(unsigned i = 0; i < i_output_nb; ++i)
+    {
+        assert(channels[i] == expected[i] && "container mismatch");
+    }
+}
+
+static void test_rotate3d()
+{
+    const unsigned i_order = 5;
+    const double yaw = 0.3, pitch = -0.8, roll = 1.1;
+    hoa::Encoder<hoa::Hoa3d, double>::Basic encoder(i_order);
+    hoa::Rotate<hoa::Hoa3d, double> rotate(i_order);
+    const unsigned i_harmo_nb = encoder.getNumberOfHarmonics();
+    std::vector<double> harmonics(i_harmo_nb), rotated(i_harmo_nb), expected(i_harmo_nb);
+    rotate.setRotation(yaw, pitch, roll);
+    for(unsigned i = 0; i < 16; ++i)
+    {
+        const double azimuth = double(rand()) / double(RAND_MAX) * HOA_2PI;
+        const double elevation = double(rand()) / double(RAND_MAX) * 3. - 1.5;
+        const double input = 1.;
+        encoder.setAzimuth(azimuth);
+        encoder.setElevation(elevation);
+        encoder.process(&input, harmonics.data());
+        rotate.process(harmonics.data(), rotated.data());
+
+        // roll around x, then pitch around y, then yaw around z
+        const double x = cos(azimuth) * cos(elevation), y = sin(azimuth) * cos(elevation), z = sin(elevation);
+        const double y1 = cos(roll) * y - sin(roll) * z, z1 = sin(roll) * y + cos(roll) * z;
+        const double x2 = cos(pitch) * x - sin(pitch) * z1, z2 = sin(pitch) * x + cos(pitch) * z1;
+        const double x3 = cos(yaw) * x2 - sin(yaw) * y1, y3 = sin(yaw) * x2 + cos(yaw) * y1;
+        encoder.setAzimuth(atan2(y3, x3));
+        encoder.setElevation(asin(z2));
+        encoder.process(&input, expected.data());
+        for(unsigned j = 0; j < i_harmo_nb; ++j)
+        {
+            assert(fabs(rotated[j] - expected[j]) < 1e-9 && "rotation mismatch");
+        }
+    }
+
+    // the orientation of the multi encoder is equivalent to the rotation of its harmonics
+    hoa::Encoder<hoa::Hoa3d, double>::Multi multi(i_order, 2);
+    const double inputs[2] = {1., -0.5};
+    multi.setAzimuth(0, 1.);
+    multi.setElevation(0, 0.4);
+    multi.setAzimuth(1, 4.);
+    multi.setRadius(1, 0.5);
+    multi.process(inputs, harmonics.data());
+    rotate.process(harmonics.data(), expected.data());
+    multi.setOrientation(yaw, pitch, roll);
+    multi.process(inputs, rotated.data());
+    for(unsigned j = 0; j < i_harmo_nb; ++j)
+    {
+        assert(fabs(rotated[j] - expected[j]) < 1e-9 && "orientation mismatch");
+    }
+    assert(fabs(multi.getYaw() - hoa::Math<double>::wrap_twopi(yaw)) < 1e-12 && "orientation yaw");
+    assert(fabs(multi.getPitch() - hoa::Math<double>::wrap_pi(pitch)) < 1e-12 && "orientation pitch");
+    assert(fabs(multi.getRoll() - hoa::Math<double>::wrap_pi(roll)) < 1e-12 && "orientation roll");
+}
+
+static void test_orientation_2d()
+{
+    const unsigned i_order = 5;
+    const double yaw = 2.3;
+    hoa::Encoder<hoa::Hoa2d, double>::Multi multi(i_order, 3);
+    hoa::Rotate<hoa::Hoa2d, double> rotate(i_order);
+    const unsigned i_harmo_nb = multi.getNumberOfHarmonics();
+    std::vector<double> harmonics(i_harmo_nb), rotated(i_harmo_nb), expected(i_harmo_nb);
+    const double inputs[3] = {1., -0.5, 0.25};
+
+    // the orientation of the multi encoder is equivalent to the rotation of its harmonics
+    multi.setAzimuth(0, 1.);
+    multi.setAzimuth(1, 4.);
+    multi.setRadius(1, 0.5);
+    multi.setAzimuth(2, -2.);
+    multi.setRadius(2, 2.);
+    multi.process(inputs, harmonics.data());
+    rotate.setYaw(yaw);
+    rotate.process(harmonics.data(), expected.data());
+    multi.setOrientation(yaw);
+    multi.process(inputs, rotated.data());
+    for(unsigned j = 0; j < i_harmo_nb; ++j)
+    {
+        assert(fabs(rotated[j] - expected[j]) < 1e-9 && "orientation 2d mismatch");
+    }
+    assert(fabs(multi.getAzimuth(0) - 1.) < 1e-12 && "orientation 2d azimuth");
+    assert(fabs(multi.getYaw() - yaw) < 1e-12 && "orientation 2d yaw");
+
+    // the azimuths set after the orientation are rotated too
+    multi.setAzimuth(0, 0.5);
+    multi.process(inputs, rotated.data());
+    multi.setOrientation(0.);
+    multi.process(inputs, harmonics.data());
+    rotate.process(harmonics.data(), expected.data());
+    for(unsigned j = 0; j < i_harmo_nb; ++j)
+    {
+        assert(fabs(rotated[j] - expected[j]) < 1e-9 && "orientation 2d azimuth mismatch");
+    }
+}
+
+static void test_wider_block()
+{
+    const unsigned i_order      = 3;
+    const unsigned i_blck_size  = 16;
+
+    hoa::Wider<hoa::Hoa3d, double> wider(i_order);
+    const unsigned i_input_nb = wider.getNumberOfHarmonics();
+    std::vector<double> block_in(i_input_nb * i_blck_size);
+    std::vector<double> block_out(i_input_nb * i_blck_size);
+    std::vector<double> frame_in(i_input_nb);
+    std::vector<double> frame_out(i_input_nb);
+    for(unsigned i = 0; i < i_input_nb * i_blck_size; ++i)
+    {
+        block_in[i] = double(rand()) / double(RAND_MAX) * 2. - 1.;
+    }
+
+    wider.setWidening(0.3);
+    wider.processBlock(i_blck_size, &block_in[0], &block_out[0]);
+    wider.setWidening(0.7);
+    wider.processBlock(i_blck_size, &block_in[0], &block_out[0]);
+    for(unsigned j = 0; j < i_input_nb; ++j)
+    {
+        frame_in[j] = block_in[j * i_blck_size + i_blck_size - 1];
+    }
+    wider.process(&frame_in[0], &frame_out[0]);
+    for(unsigned j = 0; j < i_input_nb; ++j)
+    {
+        assert(fabs(frame_out[j] - block_out[j * i_blck_size + i_blck_size - 1]) < 1e-12 && "ramp end mismatch");
+    }
+
+    wider.processBlock(i_blck_size, &block_in[0], &block_out[0]);
+    for(unsigned i = 0; i < i_blck_size; ++i)
+    {
+        for(unsigned j = 0; j < i_input_nb; ++j)
+        {
+            frame_in[j] = block_in[j * i_blck_size + i];
+        }
+        wider.process(&frame_in[0], &frame_out[0]);
+        for(unsigned j = 0; j < i_input_nb; ++j)
+        {
+            assert(fabs(frame_out[j] - block_out[j * i_blck_size + i]) < 1e-12 && "block mismatch");
+        }
+    }
+}
+
+static void test_exchanger_block()
+{
+    const unsigned i_order      = 5;
+    const unsigned i_blck_size  = 8;
+
+    hoa::Exchanger<hoa::Hoa3d, double> exchanger(i_order);
+    const unsigned i_input_nb = exchanger.getNumberOfHarmonics();
+    std::vector<double> block_in(i_input_nb * i_blck_size);
+    std::vector<double> block_out(i_input_nb * i_blck_size);
+    std::vector<double> frame_in(i_input_nb);
+    std::vector<double> frame_out(i_input_nb);
+    for(unsigned i = 0; i < i_input_nb * i_blck_size; ++i)
+    {
+        block_in[i] = double(rand()) / double(RAND_MAX) * 2. - 1.;
+    }
+
+    exchanger.setFromDaniel();
+    exchanger.processBlock(i_blck_size, &block_in[0], &block_out[0]);
+    std::vector<double> block_inplace(block_in);
+    exchanger.processBlock(i_blck_size, &block_inplace[0], &block_inplace[0]);
+    for(unsigned i = 0; i < i_blck_size; ++i)
+    {
+        for(unsigned j = 0; j < i_input_nb; ++j)
+        {
+            frame_in[j] = block_in[j * i_blck_size + i];
+        }
+        exchanger.process(&frame_in[0], &frame_out[0]);
+        for(unsigned j = 0; j < i_input_nb; ++j)
+        {
+            assert(frame_out[j] == block_out[j * i_blck_size + i] && "block mismatch");
+            assert(frame_out[j] == block_inplace[j * i_blck_size + i] && "in-place mismatch");
+        }
+    }
+
+    exchanger.setToBFormat();
+    exchanger.processBlock(i_blck_size, &block_inplace[0], &block_inplace[0]);
+    exchanger.setFromBFormat();
+    exchanger.processBlock(i_blck_size, &block_inplace[0], &block_inplace[0]);
+    for(unsigned i = 0; i < i_input_nb * i_blck_size; ++i)
+    {
+        assert(fabs(block_inplace[i] - block_out[i]) < 1e-12 && "round trip mismatch");
+    }
+
+    // The Furse-Malham index and the SN3D to MaxN gain of each ACN harmonic up to the third order
+    const unsigned fursemalham_3d[16] = {0, 2, 3, 1, 8, 6, 4, 5, 7, 15, 13, 11, 9, 10, 12, 14};
+    const double maxn_3d[16] = {1. / sqrt(2.), 1., 1., 1.,
+        2. / sqrt(3.), 2. / sqrt(3.), 1., 2. / sqrt(3.), 2. / sqrt(3.),
+        sqrt(8. / 5.), 3. / sqrt(5.), sqrt(45. / 32.), 1., sqrt(45. / 32.), 3. / sqrt(5.), sqrt(8. / 5.)};
+    const unsigned fursemalham_2d[7] = {0, 2, 1, 4, 3, 6, 5};
+    const double maxn_2d[7] = {1. / sqrt(2.), 1., 1., 1., 1., 1., 1.};
+    hoa::Exchanger<hoa::Hoa3d, double> exchanger3d(3);
+    hoa::Exchanger<hoa::Hoa2d, double> exchanger2d(3);
+    for(unsigned c = 0; c < 2; ++c)
+    {
+        const unsigned nharmonics = c ? 7 : 16;
+        const unsigned* fursemalham = c ? fursemalham_2d : fursemalham_3d;
+        const double* maxn = c ? maxn_2d : maxn_3d;
+        for(unsigned i = 0; i < nharmonics; ++i)
+        {
+            double acn[16] = {0.}, bformat[16] = {0.};
+            acn[i] = 1.;
+            if(c)
+            {
+                exchanger2d.setToBFormat();
+                exchanger2d.process(acn, bformat);
+            }
+            else
+            {
+                exchanger3d.setToBFormat();
+                exchanger3d.process(acn, bformat);
+            }
+            for(unsigned j = 0; j < nharmonics; ++j)
+            {
+                const double expected = (j == fursemalham[i]) ? maxn[i] : 0.;
+                assert(fabs(bformat[j] - expected) < 1e-12 && "exchanger to b-format");
+            }
+            if(c)
+            {
+                exchanger2d.setFromBFormat();
+                exchanger2d.process(bformat, acn);
+            }
+            else
+            {
+                exchanger3d.setFromBFormat();
+                exchanger3d.process(bformat, acn);
+            }
+            for(unsigned j = 0; j < nharmonics; ++j)
+            {
+                assert(fabs(acn[j] - (j == i ? 1. : 0.)) < 1e-12 && "exchanger from b-format");
+            }
+        }
+    }
+}
+
+static void test_regular_fft()
+{
+    const unsigned i_order      = 15;
+    const unsigned i_output_nb  = 64;
+
+    hoa::Decoder<hoa::Hoa2d, double>::Regular decoder(i_order, i_output_nb);
+    decoder.setPlanewavesRotation(0., 0., 0.3);
+    decoder.computeRendering();
+    hoa::Projector<hoa::Hoa2d, double> projector(i_order, i_output_nb);
+    const unsigned i_input_nb = decoder.getNumberOfHarmonics();
+    std::vector<double> frame_in(i_input_nb);
+    std::vector<double> frame_out(i_output_nb);
+    std::vector<double> frame_ref(i_output_nb);
+    for(unsigned i = 0; i < i_input_nb; ++i)
+    {
+        frame_in[i] = double(rand()) / double(RAND_MAX) * 2. - 1.;
+    }
+
+    decoder.process(&frame_in[0], &frame_out[0]);
+    decoder.processBlock(1, 1, &frame_in[0], &frame_ref[0]);
+    for(unsigned i = 0; i < i_output_nb; ++i)
+    {
+        assert(fabs(frame_out[i] - frame_ref[i]) < 1e-12 && "decoder mismatch");
+    }
+
+    projector.process(&frame_in[0], &frame_out[0]);
+    projector.processBlock(1, &frame_in[0], &frame_ref[0]);
+    for(unsigned i = 0; i < i_output_nb; ++i)
+    {
+        assert(fabs(frame_out[i] - frame_ref[i]) < 1e-12 && "projector mismatch");
+    }
+}
+
+static void test_scope_separable()
+{
+    const unsigned i_order  = 5;
+    const unsigned i_rows   = 17;
+    const unsigned i_cols   = 32;
+
+    hoa::Scope<hoa::Hoa3d, double> separable(i_order, i_rows, i_cols);
+    separable.setViewRotation(0., 0., 0.4);
+    separable.computeRendering();
+    hoa::Encoder<hoa::Hoa3d, double>::Basic encoder(i_order);
+    const unsigned nharmonics = encoder.getNumberOfHarmonics();
+    std::vector<double> frame_in(nharmonics);
+    std::vector<double> weights(nharmonics);
+    for(unsigned i = 0; i < nharmonics; ++i)
+    {
+        frame_in[i] = (double(rand()) / double(RAND_MAX) * 2. - 1.) * 0.1;
+        const double degree = double(encoder.getHarmonicDegree(i));
+        weights[i] = (encoder.getHarmonicOrder(i) == 0) ? (2. * degree + 1.) : (2. * degree + 1.) * 4. * HOA_PI;
+    }
+
+    // The reference is the projection of the harmonics encoded at the azimuth and the elevation of each point.
+    const double factor = 12.5 / double(nharmonics);
+    std::vector<double> row(nharmonics);
+    std::vector<double> frame_ref(i_rows * i_cols);
+    double maximum = 0.;
+    for(unsigned i = 0; i < i_rows; ++i)
+    {
+        for(unsigned j = 0; j < i_cols; ++j)
+        {
+            encoder.setAzimuth(separable.getPointAzimuth(j) + 0.4);
+            encoder.setElevation(separable.getPointElevation(i));
+            encoder.process(&factor, &row[0]);
+            double value = 0.;
+            for(unsigned k = 0; k < nharmonics; ++k)
+            {
+                value += row[k] * weights[k] * frame_in[k];
+            }
+            frame_ref[i * i_cols + j] = value;
+            maximum = std::max(maximum, fabs(value));
+        }
+    }
+
+    separable.process(&frame_in[0]);
+    const double scale = maximum > 1. ? 1. / maximum : 1.;
+    for(unsigned i = 0; i < i_rows; ++i)
+    {
+        for(unsigned j = 0; j < i_cols; ++j)
+        {
+            assert(fabs(separable.getPointValue(i, j) - frame_ref[i * i_cols + j] * scale) < 1e-9 && "scope mismatch");
+        }
+    }
+}
+
+static void test_scope_fft()
+{
+    const unsigned i_order  = 7;
+    const unsigned i_points = 360;
+
+    hoa::Scope<hoa::Hoa2d, double> scope(i_order, i_points);
+    assert(scope.isFftEnabled() && "scope fft disabled");
+
+    hoa::Encoder<hoa::Hoa2d, double>::Basic encoder(i_order);
+    const unsigned nharmonics = encoder.getNumberOfHarmonics();
+    std::vector<double> frame_in(nharmonics);
+    std::vector<double> row(nharmonics);
+    std::vector<double> frame_ref(i_points);
+    for(unsigned i = 0; i < nharmonics; ++i)
+    {
+        frame_in[i] = double(rand()) / double(RAND_MAX) * 2. - 1.;
+    }
+
+    const double factor = 1. / double(i_order + 1);
+    double maximum = 0.;
+    for(unsigned i = 0; i < i_points; ++i)
+    {
+        encoder.setAzimuth(double(i) * HOA_2PI / double(i_points));
+        encoder.process(&factor, &row[0]);
+        row[0] = factor * 0.5;
+        frame_ref[i] = 0.;
+        for(unsigned j = 0; j < nharmonics; ++j)
+        {
+            frame_ref[i] += row[j] * frame_in[j];
+        }
+        maximum = std::max(maximum, fabs(frame_ref[i]));
+    }
+
+    scope.process(&frame_in[0]);
+    assert(fabs(scope.getMaximum() - maximum) < 1e-12 && "scope fft maximum");
+    const double scale = maximum > 1. ? 1. / maximum : 1.;
+    for(unsigned i = 0; i < i_points; ++i)
+    {
+        assert(fabs(scope.getPointValue(i) - frame_ref[i] * scale) < 1e-12 && "scope fft mismatch");
+    }
+
+    // The projection without normalization leaves the points of the scope unchanged
+    std::vector<double> projected(i_points);
+    scope.project(&frame_in[0], &projected[0]);
+    for(unsigned i = 0; i < i_points; ++i)
+    {
+        assert(fabs(projected[i] - frame_ref[i]) < 1e-12 && "scope fft projection");
+        assert(fabs(scope.getPointValue(i) - frame_ref[i] * scale) < 1e-12 && "scope fft points");
+    }
+}
+
+static void test_scope_block()
+{
+    const unsigned i_order  = 3;
+    const unsigned i_points = 36;
+    const unsigned i_window = 256;
+    const unsigned i_vsize  = 100;
+
+    hoa::Encoder<hoa::Hoa2d, double>::Basic encoder(i_order);
+    hoa::Scope<hoa::Hoa2d, double> block(i_order, i_points);
+    hoa::Scope<hoa::Hoa2d, double> frame(i_order, i_points);
+    const unsigned nharmonics = encoder.getNumberOfHarmonics();
+    encoder.setAzimuth(HOA_PI2);
+    block.setWindowSize(i_window);
+    block.computeRendering();
+    frame.computeRendering();
+
+    std::vector<double> harmonics(nharmonics);
+    const double one = 1.;
+    encoder.process(&one, &harmonics[0]);
+
+    std::vector<double> inputs(nharmonics * i_vsize);
+    double energy = 0.;
+    unsigned updates = 0;
+    for(unsigned n = 0; n < 3; ++n)
+    {
+        for(unsigned k = 0; k < i_vsize; ++k)
+        {
+            const double sample = sin(double(n * i_vsize + k) * 0.05);
+            if(n * i_vsize + k < i_window)
+            {
+                energy += sample * sample;
+            }
+            for(unsigned i = 0; i < nharmonics; ++i)
+            {
+                inputs[i * i_vsize + k] = harmonics[i] * sample;
+            }
+        }
+        updates += block.processBlock(i_vsize, &inputs[0]) ? 1 : 0;
+        assert(updates == (n == 2 ? 1u : 0u) && "scope window");
+    }
+
+    const double rms = sqrt(energy / double(i_window));
+    for(unsigned i = 0; i < nharmonics; ++i)
+    {
+        harmonics[i] *= rms;
+    }
+    frame.process(&harmonics[0]);
+    for(unsigned i = 0; i < i_points; ++i)
+    {
+        assert(fabs(block.getPointValue(i) - frame.getPointValue(i)) < 1e-9 && "scope block mismatch");
+    }
+}
+
+#if (__cplusplus > 199711L)
+static void test_meter_snapshot()
+{
+    const unsigned i_channels = 4;
+    const unsigned i_vsize    = 8;
+
+    hoa::Meter<hoa::Hoa2d, double> meter(i_channels);
+    meter.setVectorSize(i_vsize);
+    meter.computeRendering();
+    hoa::Snapshot<double>& snapshot = meter.getSnapshot();
+    assert(snapshot.getSize() == i_channels * 4 && "snapshot size");
+    assert(!snapshot.poll() && "snapshot empty");
+
+    std::vector<double> frame(i_channels);
+    for(unsigned k = 0; k < i_vsize; ++k)
+    {
+        for(unsigned i = 0; i < i_channels; ++i)
+        {
+            frame[i] = (k % 2 ? 1. : -1.) * double(i + 1) * 0.25;
+        }
+        meter.process(&frame[0]);
+    }
+    assert(!snapshot.poll() && "snapshot early");
+    meter.process(&frame[0]);
+    assert(snapshot.poll() && "snapshot published");
+    assert(!snapshot.poll() && "snapshot consumed");
+    assert(snapshot.getTime() == i_vsize && "snapshot time");
+
+    const double* values = snapshot.read();
+    for(unsigned i = 0; i < i_channels; ++i)
+    {
+        const double expected = double(i + 1) * 0.25;
+        assert(fabs(values[i] - expected) < 1e-12 && "snapshot peak");
+        assert(fabs(values[i + i_channels] - expected) < 1e-12 && "snapshot rms");
+        assert(values[i + i_channels * 2] == (expected >= 1. ? 1. : 0.) && "snapshot over");
+        assert(values[i + i_channels * 3] == values[i] && "snapshot true peak");
+    }
+
+    // a snapshot without values can be created, copied and assigned
+    hoa::Snapshot<double> empty;
+    hoa::Snapshot<double> copy(empty);
+    assert(copy.getSize() == 0 && !copy.poll() && "snapshot empty copy");
+    copy = snapshot;
+    assert(copy.getSize() == i_channels * 4 && "snapshot assigned size");
+    copy = empty;
+    assert(copy.getSize() == 0 && "snapshot assigned empty");
+}
+#endif
+
+static void test_meter_block()
+{
+    const unsigned i_channels = 3;
+    const unsigned i_vsize    = 64;
+
+    hoa::Meter<hoa::Hoa3d, double> meter(i_channels);
+    meter.computeRendering();
+    meter.setTruePeak(true);
+
+    // A sine at a quarter of the sample rate whose samples never reach the peak of the wave
+    std::vector<double> inputs(i_channels * i_vsize);
+    for(unsigned n = 0; n < 4; ++n)
+    {
+        for(unsigned i = 0; i < i_channels; ++i)
+        {
+            for(unsigned k = 0; k < i_vsize; ++k)
+            {
+                inputs[i * i_vsize + k] = double(i + 1) * 0.25 * sin(double(n * i_vsize + k) * HOA_PI2 + HOA_PI4);
+            }
+        }
+        meter.processBlock(i_vsize, &inputs[0]);
+    }
+    for(unsigned i = 0; i < i_channels; ++i)
+    {
+        const double amplitude = 20. * log10(double(i + 1) * 0.25);
+        assert(fabs(meter.getPlanewaveEnergy(i) - (amplitude - 3.0103)) < 1e-3 && "block peak");
+        assert(fabs(meter.getPlanewaveRms(i) - (amplitude - 3.0103)) < 1e-3 && "block rms");
+        assert(fabs(meter.getPlanewaveTruePeak(i) - amplitude) < 0.1 && "block true peak");
+    }
+}
+
+static void test_meter_ballistics()
+{
+    const unsigned i_channels = 2;
+    const unsigned i_vsize    = 64;
+    const unsigned i_blocks   = 10;
+    const double sample_rate  = 48000.;
+    const double release      = 0.1;
+    const double integration  = 0.3;
+
+    hoa::Meter<hoa::Hoa2d, double> meter(i_channels);
+    meter.computeRendering();
+    meter.setSampleRate(sample_rate);
+    meter.setPeakRelease(release);
+    meter.setRmsTime(integration);
+    assert(meter.getSampleRate() == sample_rate && "ballistics sample rate");
+    assert(meter.getPeakRelease() == release && "ballistics peak release");
+    assert(meter.getRmsTime() == integration && "ballistics rms time");
+
+    // A burst then silence, the peaks decrease by the peak factor and the powers by the rms factor per block
+    const double peak_factor = exp(-double(i_vsize) / (release * sample_rate));
+    const double rms_factor  = exp(-double(i_vsize) / (integration * sample_rate));
+    std::vector<double> inputs(i_channels * i_vsize);
+    for(unsigned i = 0; i < i_channels; ++i)
+    {
+        for(unsigned k = 0; k < i_vsize; ++k)
+        {
+            inputs[i * i_vsize + k] = (k % 2 ? 1. : -1.) * double(i + 1) * 0.25;
+        }
+    }
+    meter.processBlock(i_vsize, &inputs[0]);
+    std::fill(inputs.begin(), inputs.end(), 0.);
+    for(unsigned n = 1; n <= i_blocks; ++n)
+    {
+        meter.processBlock(i_vsize, &inputs[0]);
+        for(unsigned i = 0; i < i_channels; ++i)
+        {
+            const double amplitude = double(i + 1) * 0.25;
+            const double peak  = amplitude * pow(peak_factor, double(n));
+            const double power = amplitude * amplitude * (1. - rms_factor) * pow(rms_factor, double(n));
+            assert(fabs(meter.getPlanewaveEnergy(i) - 20. * log10(peak)) < 1e-9 && "ballistics peak");
+            assert(fabs(meter.getPlanewaveRms(i) - 10. * log10(power)) < 1e-9 && "ballistics rms");
+        }
+    }
+}
+
+static void test_true_peak_split()
+{
+    const unsigned i_channels = 2;
+    const unsigned i_vsize    = 100;
+
+    // The blocks larger than the maximum vector size are processed in parts without any difference
+    hoa::TruePeak<double> whole(i_channels, i_vsize);
+    hoa::TruePeak<double> split(i_channels, 7);
+    assert(split.getVectorSize() == 7 && "true peak vector size");
+    std::vector<double> inputs(i_vsize);
+    for(unsigned n = 0; n < 3; ++n)
+    {
+        for(unsigned i = 0; i < i_channels; ++i)
+        {
+            for(unsigned k = 0; k < i_vsize; ++k)
+            {
+                inputs[k] = double(rand()) / double(RAND_MAX) * 2. - 1.;
+            }
+            const double expected = whole.process(i, i_vsize, &inputs[0]);
+            assert(fabs(split.process(i, i_vsize, &inputs[0]) - expected) < 1e-12 && "true peak split mismatch");
+            assert(fabs(split.process(i, 5, &inputs[0]) - whole.process(i, 5, &inputs[0])) < 1e-12 && "true peak short mismatch");
+        }
+    }
+}
+
+static void test_vector_block()
+{
+    const unsigned i_order    = 3;
+    const unsigned i_vsize    = 64;
+    const unsigned i_window   = 100;
+
+    hoa::Encoder<hoa::Hoa3d, double>::Basic encoder(i_order);
+    hoa::Decoder<hoa::Hoa3d, double>::Regular decoder(i_order, 20);
+    hoa::Vector<hoa::Hoa3d, double> vector(20);
+    encoder.setAzimuth(0.7);
+    encoder.setElevation(0.3);
+    decoder.computeRendering();
+    for(unsigned i = 0; i < 20; ++i)
+    {
+        vector.setPlanewaveAzimuth(i, decoder.getPlanewaveAzimuth(i));
+        vector.setPlanewaveElevation(i, decoder.getPlanewaveElevation(i));
+    }
+    vector.computeRendering();
+    vector.setWindowSize(i_window);
+
+    std::vector<double> harmonics(encoder.getNumberOfHarmonics());
+    std::vector<double> gains(20);
+    const double one = 1.;
+    encoder.process(&one, &harmonics[0]);
+    decoder.process(&harmonics[0], &gains[0]);
+    double expected[6];
+    vector.process(&gains[0], expected);
+
+    // All the channels share the same signal, the averaged vectors are the vectors of the gains
+    std::vector<double> inputs(20 * i_vsize);
+    double outputs[6];
+    unsigned updates = 0;
+    for(unsigned n = 0; n < 3; ++n)
+    {
+        for(unsigned i = 0; i < 20; ++i)
+        {
+            for(unsigned k = 0; k < i_vsize; ++k)
+            {
+                inputs[i * i_vsize + k] = gains[i] * sin(double(n * i_vsize + k) * 0.1);
+            }
+        }
+        updates += vector.processBlock(i_vsize, &inputs[0], outputs) ? 1 : 0;
+    }
+    assert(updates == 1 && "vector window");
+    for(unsigned i = 0; i < 6; ++i)
+    {
+        assert(fabs(outputs[i] - expected[i]) < 1e-9 && "vector block mismatch");
+    }
+
+    // A block larger than the pressure buffer is processed in parts
+    const unsigned i_large = 600;
+    vector.setWindowSize(i_large);
+    inputs.resize(20 * i_large);
+    for(unsigned i = 0; i < 20; ++i)
+    {
+        for(unsigned k = 0; k < i_large; ++k)
+        {
+            inputs[i * i_large + k] = gains[i] * sin(double(k) * 0.1);
+        }
+    }
+    assert(vector.processBlock(i_large, &inputs[0], outputs) && "vector large window");
+    for(unsigned i = 0; i < 6; ++i)
+    {
+        assert(fabs(outputs[i] - expected[i]) < 1e-9 && "vector large block mismatch");
+    }
+}
+
+static void test_voronoi_hull()
+{
+    // The faces of a cube have four points on the same circle, each corner is a neighbour of the corners of its three faces
+    hoa::Voronoi<hoa::Hoa3d> cube;
+    for(unsigned i = 0; i < 8; ++i)
+    {
+        cube.add(hoa::Voronoi<hoa::Hoa3d>::Point(i & 1 ? 1. : -1., i & 2 ? 1. : -1., i & 4 ? 1. : -1.));
+    }
+    cube.compute();
+    assert(cube.getPoints().size() == 8 && "voronoi size");
+    for(unsigned i = 0; i < 8; ++i)
+    {
+        assert(cube.getNeightbours(i).size() == 6 && "voronoi cube neighbours");
+    }
+
+    // A dense layout, each point has at least three neighbours and its bounds are around it
+    const unsigned i_points = 500;
+    hoa::Voronoi<hoa::Hoa3d> dense;
+    const double angle = HOA_PI * (3. - sqrt(5.));
+    for(unsigned i = 0; i < i_points; ++i)
+    {
+        const double z = 1. - 2. * (double(i) + 0.5) / double(i_points);
+        const double r = sqrt(1. - z * z);
+        dense.add(hoa::Voronoi<hoa::Hoa3d>::Point(r * cos(angle * double(i)), r * sin(angle * double(i)), z));
+    }
+    dense.compute();
+    for(unsigned i = 0; i < i_points; ++i)
+    {
+        assert(dense.getNeightbours(i).size() >= 3 && "voronoi neighbours");
+        for(unsigned j = 0; j < dense.getBounds(i).size(); ++j)
+        {
+            assert(dense.getBounds(i)[j].length(dense.getPoints()[i]) < 0.3 && "voronoi bounds");
+        }
+    }
+}
+
+static void test_voronoi_random()
+{
+    typedef hoa::Voronoi<hoa::Hoa3d>::Point Point;
+    const unsigned i_points = 60;
+
+    // Three points are the vertices of a cell if their circumcircle is empty. The layouts with a point close to a
+    // circumcircle are drawn again because the diagram merges the cells whose points are on the same circle.
+    hoa::Voronoi<hoa::Hoa3d> random;
+    std::vector<bool> expected;
+    bool degenerated = true;
+    while(degenerated)
+    {
+        random.clear();
+        for(unsigned i = 0; i < i_points; ++i)
+        {
+            const double z = double(rand()) / double(RAND_MAX) * 2. - 1.;
+            const double a = double(rand()) / double(RAND_MAX) * HOA_2PI;
+            const double r = sqrt(1. - z * z);
+            random.add(Point(r * cos(a), r * sin(a), z));
+        }
+        random.compute();
+        std::vector<Point> const& points = random.getPoints();
+        const size_t size = points.size();
+        expected.assign(size * size, false);
+        degenerated = false;
+        for(size_t i = 0; i < size && !degenerated; ++i)
+        {
+            for(size_t j = i + 1; j < size && !degenerated; ++j)
+            {
+                for(size_t k = j + 1; k < size && !degenerated; ++k)
+                {
+                    // The center of the circumcircle is the normal of the plane of the points on the side away from the origin
+                    const Point normal = (points[j] - points[i]).cross(points[k] - points[i]);
+                    const double side = normal.x * points[i].x + normal.y * points[i].y + normal.z * points[i].z;
+                    const double scale = (side > 0. ? 1. : -1.) / normal.length();
+                    const Point center(normal.x * scale, normal.y * scale, normal.z * scale);
+                    const double radius = center.length(points[i]);
+                    double margin = 2.;
+                    for(size_t l = 0; l < size; ++l)
+                    {
+                        if(l != i && l != j && l != k)
+                        {
+                            margin = std::min(margin, center.length(points[l]) - radius);
+                        }
+                    }
+                    degenerated = fabs(margin) < 1e-5;
+                    if(margin > 0.)
+                    {
+                        expected[i * size + j] = expected[j * size + i] = true;
+                        expected[i * size + k] = expected[k * size + i] = true;
+                        expected[j * size + k] = expected[k * size + j] = true;
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<Point> const& points = random.getPoints();
+    const size_t size = points.size();
+    for(size_t i = 0; i < size; ++i)
+    {
+        std::vector<bool> computed(size, false);
+        std::vector<Point> const& neighbours = random.getNeightbours(i);
+        for(size_t j = 0; j < neighbours.size(); ++j)
+        {
+            size_t index = 0;
+            while(index < size && points[index] != neighbours[j])
+            {
+                ++index;
+            }
+            assert(index < size && "voronoi random unknown neighbour");
+            computed[index] = true;
+        }
+        for(size_t j = 0; j < size; ++j)
+        {
+            assert(computed[j] == expected[i * size + j] && "voronoi random neighbours");
+        }
+    }
+}
+
+static void test_meter_paths()
+{
+    const unsigned i_channels = 40;
+
+    // The cached cells rotated with the view must match the cells of the rotated channels
+    hoa::Meter<hoa::Hoa3d, double> rotated(i_channels);
+    hoa::Meter<hoa::Hoa3d, double> fixed(i_channels);
+    const double angle = HOA_PI * (3. - sqrt(5.));
+    for(unsigned i = 0; i < i_channels; ++i)
+    {
+        rotated.setPlanewaveAzimuth(i, angle * double(i));
+        rotated.setPlanewaveElevation(i, asin(1. - 2. * (double(i) + 0.5) / double(i_channels)));
+    }
+    rotated.computeRendering();
+    rotated.setPlanewavesRotation(0.3, -0.2, 1.1);
+    rotated.computeRendering();
+    for(unsigned i = 0; i < i_channels; ++i)
+    {
+        fixed.setPlanewaveAzimuth(i, rotated.getPlanewaveAzimuth(i));
+        fixed.setPlanewaveElevation(i, rotated.getPlanewaveElevation(i));
+    }
+    fixed.computeRendering();
+    for(unsigned i = 0; i < i_channels; ++i)
+    {
+        for(unsigned k = 0; k < 2; ++k)
+        {
+            const hoa::Meter<hoa::Hoa3d, double>::Path& path1 = rotated.getPlanewavePath(i, k == 0);
+            const hoa::Meter<hoa::Hoa3d, double>::Path& path2 = fixed.getPlanewavePath(i, k == 0);
+            assert(path1.size() == path2.size() && "meter path size");
+            for(unsigned j = 0; j < path1.size(); ++j)
+            {
+                assert(path1[j].length(path2[j]) < 1e-6 && "meter path mismatch");
+            }
+        }
+    }
+
+    // Moving one channel of the cached meter must give the cells of a meter built with the new layout
+    rotated.setPlanewaveAzimuth(7, rotated.getPlanewaveAzimuth(7, false) + 0.2);
+    rotated.setPlanewaveElevation(7, rotated.getPlanewaveElevation(7, false) - 0.15);
+    rotated.computeRendering();
+    hoa::Meter<hoa::Hoa3d, double> fresh(i_channels);
+    for(unsigned i = 0; i < i_channels; ++i)
+    {
+        fresh.setPlanewaveAzimuth(i, rotated.getPlanewaveAzimuth(i, false));
+        fresh.setPlanewaveElevation(i, rotated.getPlanewaveElevation(i, false));
+    }
+    fresh.setPlanewavesRotation(0.3, -0.2, 1.1);
+    fresh.computeRendering();
+    for(unsigned i = 0; i < i_channels; ++i)
+    {
+        for(unsigned k = 0; k < 2; ++k)
+        {
+            const hoa::Meter<hoa::Hoa3d, double>::Path& path1 = rotated.getPlanewavePath(i, k == 0);
+            const hoa::Meter<hoa::Hoa3d, double>::Path& path2 = fresh.getPlanewavePath(i, k == 0);
+            assert(path1.size() == path2.size() && "meter moved path size");
+            for(unsigned j = 0; j < path1.size(); ++j)
+            {
+                assert(path1[j].length(path2[j]) < 1e-9 && "meter moved path mismatch");
+            }
+        }
+    }
+}
+
+static void test_activity_peaks()
+{
+    const unsigned i_order  = 3;
+    const unsigned i_rows   = 19;
+    const unsigned i_cols   = 36;
+    const unsigned i_window = 2048;
+    const unsigned i_vsize  = 256;
+    const double azimuths[]   = {1.05, 4.1};
+    const double elevations[] = {0.3, -0.45};
+    const double gains[]      = {1., 0.6};
+
+    hoa::Encoder<hoa::Hoa3d, double>::Basic encoder(i_order);
+    hoa::Activity<hoa::Hoa3d, double> activity(i_order, i_rows, i_cols, 4);
+    const unsigned nharmonics = encoder.getNumberOfHarmonics();
+    activity.setWindowSize(i_window);
+
+    std::vector<double> harmonics(nharmonics * 2);
+    for(unsigned s = 0; s < 2; ++s)
+    {
+        encoder.setAzimuth(azimuths[s]);
+        encoder.setElevation(elevations[s]);
+        encoder.process(gains + s, &harmonics[s * nharmonics]);
+    }
+
+    std::vector<double> inputs(nharmonics * i_vsize);
+    for(unsigned n = 0; n < i_window / i_vsize; ++n)
+    {
+        assert(!activity.analyze() && "activity analysis without covariance");
+        for(unsigned k = 0; k < i_vsize; ++k)
+        {
+            const double time = double(n * i_vsize + k);
+            const double first = sin(time * 0.031), second = sin(time * 0.17 + 0.5);
+            for(unsigned i = 0; i < nharmonics; ++i)
+            {
+                inputs[i * i_vsize + k] = harmonics[i] * first + harmonics[nharmonics + i] * second;
+            }
+        }
+        assert(activity.processBlock(i_vsize, &inputs[0]) == (n == i_window / i_vsize - 1) && "activity window");
+    }
+    assert(activity.analyze() && "activity analysis");
+    assert(!activity.analyze() && "activity analysis without new covariance");
+
+    assert(activity.getNumberOfPeaks() >= 2 && "activity number of peaks");
+    for(unsigned s = 0; s < 2; ++s)
+    {
+        const double azimuth = activity.getPeakAzimuth(s) - azimuths[s];
+        const double elevation = activity.getPeakElevation(s) - elevations[s];
+        assert(fabs(atan2(sin(azimuth), cos(azimuth))) < 0.05 && "activity peak azimuth");
+        assert(fabs(elevation) < 0.05 && "activity peak elevation");
+    }
+    for(unsigned i = 1; i < activity.getNumberOfPeaks(); ++i)
+    {
+        assert(activity.getPeakPower(i) <= activity.getPeakPower(i - 1) && "activity peaks order");
+    }
+}
+
+static void fill_activity_2d(const unsigned nharmonics, const unsigned vectorsize, const unsigned start, const double* harmonics, double* inputs)
+{
+    for(unsigned k = 0; k < vectorsize; ++k)
+    {
+        const double time = double(start + k);
+        const double first = sin(time * 0.031), second = sin(time * 0.17 + 0.5);
+        for(unsigned i = 0; i < nharmonics; ++i)
+        {
+            inputs[i * vectorsize + k] = harmonics[i] * first + harmonics[nharmonics + i] * second;
+        }
+    }
+}
+
+static bool check_activity_2d(const hoa::Activity<hoa::Hoa2d, double>& activity, const double* azimuths, const double tolerance)
+{
+    if(activity.getNumberOfPeaks() < 2)
+    {
+        return false;
+    }
+    for(unsigned s = 0; s < 2; ++s)
+    {
+        const double azimuth = activity.getPeakAzimuth(s) - azimuths[s];
+        if(fabs(atan2(sin(azimuth), cos(azimuth))) >= tolerance)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void test_activity_2d()
+{
+    const unsigned i_order  = 5;
+    const unsigned i_points = 360;
+    const unsigned i_window = 2048;
+    const unsigned i_vsize  = 256;
+    const double azimuths[] = {1.05, 4.1};
+    const double gains[]    = {1., 0.6};
+
+    hoa::Encoder<hoa::Hoa2d, double>::Basic encoder(i_order);
+    hoa::Activity<hoa::Hoa2d, double> activity(i_order, i_points, 4);
+    const unsigned nharmonics = encoder.getNumberOfHarmonics();
+    activity.setWindowSize(i_window);
+
+    std::vector<double> harmonics(nharmonics * 2);
+    for(unsigned s = 0; s < 2; ++s)
+    {
+        encoder.setAzimuth(azimuths[s]);
+        encoder.process(gains + s, &harmonics[s * nharmonics]);
+    }
+
+    std::vector<double> inputs(nharmonics * i_vsize);
+    for(unsigned n = 0; n < i_window / i_vsize; ++n)
+    {
+        assert(!activity.analyze() && "activity 2d analysis without covariance");
+        fill_activity_2d(nharmonics, i_vsize, n * i_vsize, &harmonics[0], &inputs[0]);
+        assert(activity.processBlock(i_vsize, &inputs[0]) == (n == i_window / i_vsize - 1) && "activity 2d window");
+    }
+    assert(activity.analyze() && "activity 2d analysis");
+    assert(!activity.analyze() && "activity 2d analysis without new covariance");
+    assert(check_activity_2d(activity, azimuths, 0.015) && "activity 2d peaks");
+    for(unsigned i = 1; i < activity.getNumberOfPeaks(); ++i)
+    {
+        assert(activity.getPeakPower(i) <= activity.getPeakPower(i - 1) && "activity 2d peaks order");
+    }
+}
+
+#if (__cplusplus > 199711L)
+static void test_activity_threads()
+{
+    const unsigned i_order   = 5;
+    const unsigned i_points  = 360;
+    const unsigned i_window  = 2048;
+    const unsigned i_vsize   = 256;
+    const unsigned i_windows = 64;
+    const double azimuths[2][2] = {{1.05, 4.1}, {2.5, 5.6}};
+    const double gains[]        = {1., 0.6};
+
+    hoa::Encoder<hoa::Hoa2d, double>::Basic encoder(i_order);
+    hoa::Activity<hoa::Hoa2d, double> activity(i_order, i_points, 4);
+    const unsigned nharmonics = encoder.getNumberOfHarmonics();
+    activity.setWindowSize(i_window);
+
+    // Two scenes alternate from one window to another, a torn covariance would mix them
+    std::vector<double> harmonics(nharmonics * 4);
+    for(unsigned c = 0; c < 2; ++c)
+    {
+        for(unsigned s = 0; s < 2; ++s)
+        {
+            encoder.setAzimuth(azimuths[c][s]);
+            encoder.process(gains + s, &harmonics[(c * 2 + s) * nharmonics]);
+        }
+    }
+
+    // The covariances are accumulated by the audio thread and analyzed by the caller
+    std::atomic<bool> done(false);
+    std::thread audio([&]()
+    {
+        std::vector<double> inputs(nharmonics * i_vsize);
+        for(unsigned n = 0; n < i_windows * (i_window / i_vsize); ++n)
+        {
+            const unsigned scene = (n / (i_window / i_vsize)) % 2;
+            fill_activity_2d(nharmonics, i_vsize, n * i_vsize, &harmonics[scene * 2 * nharmonics], &inputs[0]);
+            activity.processBlock(i_vsize, &inputs[0]);
+        }
+        done.store(true);
+    });
+    unsigned analyses = 0;
+    while(!done.load())
+    {
+        if(activity.analyze())
+        {
+            assert((check_activity_2d(activity, azimuths[0], 0.015) || check_activity_2d(activity, azimuths[1], 0.015)) && "activity threads peaks");
+            ++analyses;
+        }
+        std::this_thread::yield();
+    }
+    audio.join();
+    if(activity.analyze())
+    {
+        assert(check_activity_2d(activity, azimuths[1], 0.015) && "activity threads last peaks");
+        ++analyses;
+    }
+    assert(analyses > 0 && "activity threads analyses");
+}
+#endif
+
+static void test_binaural_tail()
+{
+    const unsigned i_order   = 3;
+    const unsigned i_vsize   = 64;
+    const unsigned i_blocks  = 12;
+    const unsigned i_length  = i_vsize * i_blocks;
+
+    hoa::Decoder<hoa::Hoa2d, double>::Binaural blocks(i_order);
+    hoa::Decoder<hoa::Hoa2d, double>::Binaural whole(i_order);
+    const unsigned nharmonics = blocks.getNumberOfHarmonics();
+    blocks.computeRendering(i_vsize);
+    whole.computeRendering(i_length);
+
+    // two blocks of noise, then silence until the tail has decayed, then one block of noise and silence
+    std::vector<double> harmonics(nharmonics * i_length, 0.);
+    for(unsigned i = 0; i < nharmonics; ++i)
+    {
+        for(unsigned k = 0; k < i_length; ++k)
+        {
+            const unsigned block = k / i_vsize;
+            if(block < 2 || block == 10)
+            {
+                harmonics[i * i_length + k] = double(rand()) / double(RAND_MAX) * 2. - 1.;
+            }
+        }
+    }
+
+    std::vector<const double*> inputs(nharmonics);
+    std::vector<double> left(i_length), right(i_length);
+    double* outputs[2] = {&left[0], &right[0]};
+    for(unsigned i = 0; i < nharmonics; ++i)
+    {
+        inputs[i] = &harmonics[i * i_length];
+    }
+    whole.processBlock(&inputs[0], outputs);
+
+    std::vector<double> block_left(i_vsize), block_right(i_vsize);
+    double* block_outputs[2] = {&block_left[0], &block_right[0]};
+    for(unsigned n = 0; n < i_blocks; ++n)
+    {
+        for(unsigned i = 0; i < nharmonics; ++i)
+        {
+            inputs[i] = &harmonics[i * i_length + n * i_vsize];
+        }
+        blocks.processBlock(&inputs[0], block_outputs);
+        for(unsigned k = 0; k < i_vsize; ++k)
+        {
+            assert(fabs(block_left[k] - left[n * i_vsize + k]) < 1e-9 && "binaural tail left");
+            assert(fabs(block_right[k] - right[n * i_vsize + k]) < 1e-9 && "binaural tail right");
+        }
+    }
+}
+
+static void test_optim_block()
+{
+    const unsigned i_order = 4;
+    const unsigned i_vsize = 9;
+
+    hoa::Optim<hoa::Hoa3d, double>::MaxRe maxre(i_order);
+    hoa::Optim<hoa::Hoa2d, double>::InPhase inphase(i_order);
+    const unsigned nharmonics = maxre.getNumberOfHarmonics();
+    std::vector<double> inputs(nharmonics * i_vsize), outputs(nharmonics * i_vsize);
+    std::vector<double> frame_in(nharmonics), frame_out(nharmonics);
+
+    for(unsigned n = 0; n < 2; ++n)
+    {
+        for(unsigned i = 0; i < nharmonics * i_vsize; ++i)
+        {
+            inputs[i] = n ? 0. : double(rand()) / double(RAND_MAX) * 2. - 1.;
+        }
+        assert(hoa::Signal<double>::isZero(nharmonics * i_vsize, &inputs[0]) == (n == 1) && "signal is zero");
+
+        std::fill(outputs.begin(), outputs.end(), 1.);
+        maxre.processBlock(i_vsize, &inputs[0], &outputs[0]);
+        for(unsigned k = 0; k < i_vsize; ++k)
+        {
+            hoa::Signal<double>::copy(nharmonics, &inputs[k], i_vsize, &frame_in[0], 1);
+            maxre.process(&frame_in[0], &frame_out[0]);
+            for(unsigned i = 0; i < nharmonics; ++i)
+            {
+                assert(fabs(outputs[i * i_vsize + k] - frame_out[i]) < 1e-12 && "optim maxre block");
+            }
+        }
+
+        const unsigned ncircular = inphase.getNumberOfHarmonics();
+        std::fill(outputs.begin(), outputs.end(), 1.);
+        inphase.processBlock(i_vsize, &inputs[0], &outputs[0]);
+        for(unsigned k = 0; k < i_vsize; ++k)
+        {
+            hoa::Signal<double>::copy(ncircular, &inputs[k], i_vsize, &frame_in[0], 1);
+            inphase.process(&frame_in[0], &frame_out[0]);
+            for(unsigned i = 0; i < ncircular; ++i)
+            {
+                assert(fabs(outputs[i * i_vsize + k] - frame_out[i]) < 1e-12 && "optim inphase block");
+            }
+        }
+    }
+
+    // the out-of-place scale and the overlapping move
+    double vector[11];
+    for(unsigned i = 0; i < 11; ++i)
+    {
+        vector[i] = double(i);
+    }
+    hoa::Signal<double>::scale(9, 0.5, vector, &frame_out[0]);
+    hoa::Signal<double>::move(8, vector + 3, vector);
+    for(unsigned i = 0; i < 8; ++i)
+    {
+        assert(vector[i] == double(i + 3) && "signal move");
+    }
+    for(unsigned i = 0; i < 9; ++i)
+    {
+        assert(frame_out[i] == double(i) * 0.5 && "signal scale");
+    }
+}
+
+static void test_harmonic_tables()
+{
+    hoa::Encoder<hoa::Hoa3d, float>::Basic first(5);
+    hoa::Decoder<hoa::Hoa3d, float>::Regular second(5, 40);
+    hoa::Encoder<hoa::Hoa3d, float>::Basic other(4);
+    assert(&first.getHarmonicTable() == &second.getHarmonicTable() && "harmonic table shared");
+    assert(&first.getHarmonicTable() != &other.getHarmonicTable() && "harmonic table per order");
+
+    const hoa::HarmonicTable<hoa::Hoa3d, float>& table = first.getHarmonicTable();
+    assert(table.getDecompositionOrder() == 5 && table.getNumberOfHarmonics() == 36 && "harmonic table size");
+    for(unsigned i = 0; i < table.getNumberOfHarmonics(); ++i)
+    {
+        const hoa::Harmonic<hoa::Hoa3d, float> harmonic(i);
+        assert(table.getDegree(i) == harmonic.getDegree() && "harmonic table degree");
+        assert(table.getOrder(i) == harmonic.getOrder() && "harmonic table order");
+        assert(table.getNormalization(i) == harmonic.getNormalization() && "harmonic table normalization");
+        assert(table.getSemiNormalization(i) == harmonic.getSemiNormalization() && "harmonic table semi-normalization");
+    }
+
+    const hoa::HarmonicTable<hoa::Hoa2d, double>& circular = hoa::HarmonicTable<hoa::Hoa2d, double>::get(7);
+    for(unsigned i = 0; i < circular.getNumberOfHarmonics(); ++i)
+    {
+        const hoa::Harmonic<hoa::Hoa2d, double> harmonic(i);
+        assert(circular.getDegree(i) == harmonic.getDegree() && "harmonic table 2d degree");
+        assert(circular.getOrder(i) == harmonic.getOrder() && "harmonic table 2d order");
+    }
+}
+
+#if (__cplusplus > 199711L)
+static void test_harmonic_tables_concurrent()
+{
+    // an order that no other test requests, so the table is created by the threads
+    const size_t order = 23;
+    std::vector<const hoa::HarmonicTable<hoa::Hoa3d, double>*> tables(4, hoa_nullptr);
+    std::vector<std::thread> threads;
+    for(size_t i = 0; i < tables.size(); ++i)
+    {
+        threads.push_back(std::thread([&tables, i, order]() {
+            tables[i] = &hoa::HarmonicTable<hoa::Hoa3d, double>::get(order);
+        }));
+    }
+    for(size_t i = 0; i < threads.size(); ++i)
+    {
+        threads[i].join();
+    }
+    for(size_t i = 0; i < tables.size(); ++i)
+    {
+        assert(tables[i] == tables[0] && "harmonic table concurrent get");
+    }
+    assert(tables[0]->getNumberOfHarmonics() == (order + 1) * (order + 1) && "harmonic table concurrent size");
+    hoa::Encoder<hoa::Hoa3d, double>::Basic encoder(order);
+    assert(&encoder.getHarmonicTable() == tables[0] && "harmonic table concurrent shared");
+}
+#endif
+
+static void test_harmonic_degrees()
+{
+    typedef hoa::Harmonic<hoa::Hoa3d, float> harmonic;
+    for(size_t order = 1; order <= 15; ++order)
+    {
+        const hoa::HarmonicTable<hoa::Hoa3d, float>& table = hoa::HarmonicTable<hoa::Hoa3d, float>::get(order);
+        const size_t* degrees = table.getDegrees();
+        const long* orders    = table.getOrders();
+        for(size_t i = 0; i < table.getNumberOfHarmonics(); ++i)
+        {
+            // the former floating point formula is exact for these indices
+            const size_t degree = size_t(sqrt(float(i)));
+            const long azimuthal = long(i) - long(degree * (degree + 1));
+            assert(degrees[i] == degree && table.getDegree(i) == degree && "harmonic degree");
+            assert(orders[i] == azimuthal && table.getOrder(i) == azimuthal && "harmonic order");
+            assert(harmonic::getIndex(degree, azimuthal) == i && "harmonic index");
+        }
+
+        const hoa::HarmonicTable<hoa::Hoa2d, float>& circular = hoa::HarmonicTable<hoa::Hoa2d, float>::get(order);
+        for(size_t i = 0; i < circular.getNumberOfHarmonics(); ++i)
+        {
+            assert(circular.getDegrees()[i] == (i + i % 2) / 2 && "circular harmonic degree");
+            assert(circular.getOrders()[i] == long(i % 2 ? -long((i + 1) / 2) : long(i / 2)) && "circular harmonic order");
+        }
+    }
+
+    // the integer degree stays exact where the float square root rounds up
+    const size_t large = 4096ul * 4096ul - 1ul;
+    assert(harmonic::getDegree(large) == 4095ul && "harmonic large degree");
+    assert(harmonic::getOrder(large) == 4095l && "harmonic large order");
+}
+
+static void test_planewaves_cache()
+{
+    const unsigned i_planewaves = 12;
+    typedef hoa::Planewave<hoa::Hoa3d, double> planewave;
+    hoa::Processor<hoa::Hoa3d, double>::Planewaves planewaves(i_planewaves);
+    std::vector<double> azimuths(i_planewaves), elevations(i_planewaves);
+    for(unsigned i = 0; i < i_planewaves; ++i)
+    {
+        azimuths[i]   = double(rand()) / double(RAND_MAX) * HOA_2PI;
+        elevations[i] = double(rand()) / double(RAND_MAX) * HOA_PI - HOA_PI2;
+        planewaves.setPlanewaveAzimuth(i, azimuths[i]);
+        planewaves.setPlanewaveElevation(i, elevations[i]);
+    }
+
+    for(unsigned r = 0; r < 4; ++r)
+    {
+        const double x = r ? double(rand()) / double(RAND_MAX) * HOA_2PI : 0.;
+        const double y = r ? double(rand()) / double(RAND_MAX) * HOA_2PI : 0.;
+        const double z = r ? double(rand()) / double(RAND_MAX) * HOA_2PI : 0.;
+        planewaves.setPlanewavesRotation(x, y, z);
+
+        // a planewave changed after the rotation only recomputes its own coordinates
+        azimuths[r] = double(rand()) / double(RAND_MAX) * HOA_2PI;
+        elevations[(r + 5) % i_planewaves] = double(rand()) / double(RAND_MAX) * HOA_PI - HOA_PI2;
+        planewaves.setPlanewaveAzimuth(r, azimuths[r]);
+        planewaves.setPlanewaveElevation((r + 5) % i_planewaves, elevations[(r + 5) % i_planewaves]);
+
+        for(unsigned i = 0; i < i_planewaves; ++i)
+        {
+            const planewave reference(i, azimuths[i], elevations[i]);
+            assert(fabs(planewaves.getPlanewaveAzimuth(i) - reference.getAzimuth(x, y, z)) < 1e-12 && "cached azimuth");
+            assert(fabs(planewaves.getPlanewaveElevation(i) - reference.getElevation(x, y, z)) < 1e-12 && "cached elevation");
+            assert(fabs(planewaves.getPlanewaveAbscissa(i) - reference.getAbscissa(x, y, z)) < 1e-12 && "cached abscissa");
+            assert(fabs(planewaves.getPlanewaveOrdinate(i) - reference.getOrdinate(x, y, z)) < 1e-12 && "cached ordinate");
+            assert(fabs(planewaves.getPlanewaveHeight(i) - reference.getHeight(x, y, z)) < 1e-12 && "cached height");
+            assert(fabs(planewaves.getPlanewaveAbscissa(i, false) - reference.getAbscissa(0., 0., 0.)) < 1e-12 && "unrotated abscissa");
+            assert(fabs(planewaves.getPlanewaveHeight(i, false) - reference.getHeight(0., 0., 0.)) < 1e-12 && "unrotated height");
+
+            assert(planewaves.getPlanewavesAzimuth()[i] == planewaves.getPlanewaveAzimuth(i) && "cached azimuths");
+            assert(planewaves.getPlanewavesElevation()[i] == planewaves.getPlanewaveElevation(i) && "cached elevations");
+            assert(planewaves.getPlanewavesAbscissa()[i] == planewaves.getPlanewaveAbscissa(i) && "cached abscissas");
+            assert(planewaves.getPlanewavesOrdinate()[i] == planewaves.getPlanewaveOrdinate(i) && "cached ordinates");
+            assert(planewaves.getPlanewavesHeight()[i] == planewaves.getPlanewaveHeight(i) && "cached heights");
+        }
+    }
+}
+
+static void test_rotate_ramp()
+{
+    const unsigned i_order = 5;
+    const unsigned i_vsize = 150;
+    hoa::Rotate<hoa::Hoa2d, double> block(i_order);
+    hoa::Rotate<hoa::Hoa2d, double> frame(i_order);
+    const unsigned nharmonics = block.getNumberOfHarmonics();
+    std::vector<double> inputs(nharmonics * i_vsize), outputs(nharmonics * i_vsize), yaws(i_vsize);
+    std::vector<double> frame_in(nharmonics), frame_out(nharmonics);
+    for(unsigned i = 0; i < nharmonics * i_vsize; ++i)
+    {
+        inputs[i] = double(rand()) / double(RAND_MAX) * 2. - 1.;
+    }
+
+    // a yaw for each sample
+    for(unsigned k = 0; k < i_vsize; ++k)
+    {
+        yaws[k] = 0.3 + 4. * sin(double(k) * 0.02);
+    }
+    block.processBlockRamp(i_vsize, &inputs[0], &outputs[0], &yaws[0]);
+    for(unsigned k = 0; k < i_vsize; ++k)
+    {
+        hoa::Signal<double>::copy(nharmonics, &inputs[k], i_vsize, &frame_in[0], 1);
+        frame.setYaw(yaws[k]);
+        frame.process(&frame_in[0], &frame_out[0]);
+        for(unsigned i = 0; i < nharmonics; ++i)
+        {
+            assert(fabs(outputs[i * i_vsize + k] - frame_out[i]) < 1e-12 && "rotate ramp mismatch");
+        }
+    }
+    assert(fabs(block.getYaw() - frame.getYaw()) < 1e-12 && "rotate ramp last yaw");
+
+    // a linear move by the shortest path to the yaw of the end of the block
+    const double start = block.getYaw(), end = 0.1;
+    const double step = hoa::Math<double>::wrap_pi(end - start) / double(i_vsize);
+    block.processBlock(i_vsize, &inputs[0], &outputs[0], end);
+    for(unsigned k = 0; k < i_vsize; ++k)
+    {
+        hoa::Signal<double>::copy(nharmonics, &inputs[k], i_vsize, &frame_in[0], 1);
+        frame.setYaw(start + step * double(k + 1));
+        frame.process(&frame_in[0], &frame_out[0]);
+        for(unsigned i = 0; i < nharmonics; ++i)
+        {
+            assert(fabs(outputs[i * i_vsize + k] - frame_out[i]) < 1e-12 && "rotate linear mismatch");
+        }
+    }
+    assert(fabs(block.getYaw() - end) < 1e-12 && "rotate linear last yaw");
+
+    // a literal yaw is not ambiguous
+    block.processBlock(i_vsize, &inputs[0], &outputs[0], 0);
+    assert(fabs(sin(block.getYaw())) < 1e-12 && cos(block.getYaw()) > 0. && "rotate literal yaw");
+}
+
+static void test_rotation_cache()
+{
+    const unsigned i_order = 3;
+    const double resolution = HOA_PI / 180.;
+    hoa::RotationCache<double> cache(i_order, 2, resolution);
+    hoa::Rotate<hoa::Hoa3d, double> cached(i_order), exact(i_order), other(i_order);
+    const unsigned nharmonics = cached.getNumberOfHarmonics();
+    std::vector<double> inputs(nharmonics), outputs(nharmonics), expected(nharmonics), others(nharmonics);
+    for(unsigned i = 0; i < nharmonics; ++i)
+    {
+        inputs[i] = double(rand()) / double(RAND_MAX) * 2. - 1.;
+    }
+
+    // hits for the same orientation and for an orientation in the same cell
+    cached.setRotation(0.7, 0.3, -0.2, cache);
+    assert(cache.getNumberOfRotations() == 1 && "rotation cache first miss");
+    other.setRotation(0.7, 0.3, -0.2, cache);
+    assert(cache.getNumberOfRotations() == 1 && "rotation cache hit");
+    other.setRotation(0.7 + resolution * 0.01, 0.3, -0.2, cache);
+    assert(cache.getNumberOfRotations() == 1 && "rotation cache quantized hit");
+    cached.process(&inputs[0], &outputs[0]);
+    other.process(&inputs[0], &others[0]);
+    for(unsigned i = 0; i < nharmonics; ++i)
+    {
+        assert(outputs[i] == others[i] && "rotation cache same cell");
+    }
+
+    // the quantized rotation is close to the exact one
+    assert(fabs(cached.getYaw() - 0.7) < resolution && "rotation cache yaw");
+    assert(fabs(cached.getPitch() - 0.3) < resolution && "rotation cache pitch");
+    assert(fabs(cached.getRoll() + 0.2) < resolution && "rotation cache roll");
+    exact.setRotation(cached.getYaw(), cached.getPitch(), cached.getRoll());
+    exact.process(&inputs[0], &expected[0]);
+    for(unsigned i = 0; i < nharmonics; ++i)
+    {
+        assert(fabs(outputs[i] - expected[i]) < 1e-12 && "rotation cache quantized angles");
+    }
+    exact.setRotation(0.7, 0.3, -0.2);
+    exact.process(&inputs[0], &expected[0]);
+    for(unsigned i = 0; i < nharmonics; ++i)
+    {
+        assert(fabs(outputs[i] - expected[i]) < 0.1 && "rotation cache quantization");
+    }
+
+    // the least recently used rotation is evicted
+    cached.setRotation(1.5, 0., 0., cache);
+    cached.setRotation(0.7, 0.3, -0.2, cache);
+    cached.setRotation(-1., 0.5, 0.1, cache);
+    assert(cache.getNumberOfRotations() == 2 && "rotation cache capacity");
+    assert(cache.contains(0.7, 0.3, -0.2) && "rotation cache recent kept");
+    assert(cache.contains(-1., 0.5, 0.1) && "rotation cache last kept");
+    assert(!cache.contains(1.5, 0., 0.) && "rotation cache least recent evicted");
+
+    cache.clear();
+    assert(cache.getNumberOfRotations() == 0 && "rotation cache clear");
+    assert(!cache.contains(0.7, 0.3, -0.2) && "rotation cache cleared");
+}
 
 int main(int argc, char** argv)
 {
     std::cout << "binaural...";
     test_binaural();
     std::cout << "ok\n";
+    std::cout << "harmonic tables...";
+    test_harmonic_tables();
+    std::cout << "ok\n";
+    std::cout << "harmonic degrees...";
+    test_harmonic_degrees();
+    std::cout << "ok\n";
+    std::cout << "planewaves cache...";
+    test_planewaves_cache();
+    std::cout << "ok\n";
+    std::cout << "binaural tail...";
+    test_binaural_tail();
+    std::cout << "ok\n";
+    std::cout << "optim block...";
+    test_optim_block();
+    std::cout << "ok\n";
+    std::cout << "decoder batch...";
+    test_decoder_batch();
+    std::cout << "ok\n";
+    std::cout << "containers...";
+    test_containers();
+    std::cout << "ok\n";
+    std::cout << "rotate ramp...";
+    test_rotate_ramp();
+    std::cout << "ok\n";
+    std::cout << "rotation cache...";
+    test_rotation_cache();
+    std::cout << "ok\n";
+    std::cout << "rotate 3d...";
+    test_rotate3d();
+    std::cout << "ok\n";
+    std::cout << "orientation 2d...";
+    test_orientation_2d();
+    std::cout << "ok\n";
+    std::cout << "wider block...";
+    test_wider_block();
+    std::cout << "ok\n";
+    std::cout << "exchanger block...";
+    test_exchanger_block();
+    std::cout << "ok\n";
+    std::cout << "regular fft...";
+    test_regular_fft();
+    std::cout << "ok\n";
+    std::cout << "scope separable...";
+    test_scope_separable();
+    std::cout << "ok\n";
+    std::cout << "scope fft...";
+    test_scope_fft();
+    std::cout << "ok\n";
+    std::cout << "scope block...";
+    test_scope_block();
+    std::cout << "ok\n";
+    std::cout << "meter block...";
+    test_meter_block();
+    std::cout << "ok\n";
+    std::cout << "meter ballistics...";
+    test_meter_ballistics();
+    std::cout << "ok\n";
+    std::cout << "true peak split...";
+    test_true_peak_split();
+    std::cout << "ok\n";
+    std::cout << "vector block...";
+    test_vector_block();
+    std::cout << "ok\n";
+    std::cout << "voronoi hull...";
+    test_voronoi_hull();
+    std::cout << "ok\n";
+    std::cout << "voronoi random...";
+    test_voronoi_random();
+    std::cout << "ok\n";
+    std::cout << "meter paths...";
+    test_meter_paths();
+    std::cout << "ok\n";
+    std::cout << "activity peaks...";
+    test_activity_peaks();
+    std::cout << "ok\n";
+    std::cout << "activity 2d...";
+    test_activity_2d();
+    std::cout << "ok\n";
+#if (__cplusplus > 199711L)
+    std::cout << "harmonic tables concurrent...";
+    test_harmonic_tables_concurrent();
+    std::cout << "ok\n";
+    std::cout << "pool...";
+    test_pool();
+    std::cout << "ok\n";
+    std::cout << "ring copy...";
+    test_ring_copy();
+    std::cout << "ok\n";
+    std::cout << "ring in place...";
+    test_ring_inplace();
+    std::cout << "ok\n";
+    std::cout << "decoder workers...";
+    test_decoder_workers();
+    std::cout << "ok\n";
+    std::cout << "meter snapshot...";
+    test_meter_snapshot();
+    std::cout << "ok\n";
+    std::cout << "activity threads...";
+    test_activity_threads();
+    std::cout << "ok\n";
+#endif
     return 0;
 }